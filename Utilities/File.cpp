@@ -272,6 +272,19 @@ namespace fs
 		return this->write(buf.get(), total);
 	}
 
+	u64 file_base::read_at(u64, void*, u64)
+	{
+		// Positional access requires native support
+		g_tls_error = error::inval;
+		return -1;
+	}
+
+	u64 file_base::write_at(u64, const void*, u64)
+	{
+		g_tls_error = error::inval;
+		return -1;
+	}
+
 	dir_base::~dir_base()
 	{
 	}
@@ -1103,15 +1116,90 @@ fs::file::file(const std::string& path, bs_t<open_mode> mode)
 	class windows_file final : public file_base
 	{
 		const HANDLE m_handle;
+		const DWORD m_access;
+		const DWORD m_share;
+
+		// Handle for positional access (overlapped handles have no file pointer), opened on demand
+		shared_mutex m_ovl_mutex;
+		HANDLE m_ovl_handle = nullptr;
+
+		HANDLE get_overlapped_handle()
+		{
+			std::lock_guard lock(m_ovl_mutex);
+
+			if (!m_ovl_handle)
+			{
+				m_ovl_handle = ReOpenFile(m_handle, m_access, m_share, FILE_FLAG_OVERLAPPED);
+			}
+
+			return m_ovl_handle;
+		}
+
+		template <typename T, typename F>
+		u64 overlapped_op(u64 offset, T* buffer, u64 count, F&& op)
+		{
+			const HANDLE handle = get_overlapped_handle();
+
+			if (handle == INVALID_HANDLE_VALUE)
+			{
+				g_tls_error = error::inval;
+				return -1;
+			}
+
+			OVERLAPPED ovl{};
+			ovl.hEvent = ensure(CreateEventW(nullptr, TRUE, FALSE, nullptr));
+
+			u64 nsum = 0;
+
+			for (T* data = buffer; count;)
+			{
+				const DWORD size = static_cast<DWORD>(std::min<u64>(count, DWORD{umax} & -4096));
+
+				ovl.Offset = static_cast<DWORD>(offset + nsum);
+				ovl.OffsetHigh = static_cast<DWORD>((offset + nsum) >> 32);
+
+				DWORD ndone = 0;
+
+				if (!op(handle, data, size, &ovl) && GetLastError() != ERROR_IO_PENDING)
+				{
+					// Reading past the end
+					ensure(GetLastError() == ERROR_HANDLE_EOF); // "file::overlapped_op"
+				}
+				else if (!GetOverlappedResult(handle, &ovl, &ndone, TRUE))
+				{
+					ensure(GetLastError() == ERROR_HANDLE_EOF); // "file::overlapped_op"
+				}
+
+				nsum += ndone;
+
+				if (ndone < size)
+				{
+					break;
+				}
+
+				count -= size;
+				data += size;
+			}
+
+			CloseHandle(ovl.hEvent);
+			return nsum;
+		}
 
 	public:
-		windows_file(HANDLE handle)
+		windows_file(HANDLE handle, DWORD access, DWORD share)
 			: m_handle(handle)
+			, m_access(access)
+			, m_share(share)
 		{
 		}
 
 		~windows_file() override
 		{
+			if (m_ovl_handle && m_ovl_handle != INVALID_HANDLE_VALUE)
+			{
+				CloseHandle(m_ovl_handle);
+			}
+
 			CloseHandle(m_handle);
 		}
 
@@ -1201,6 +1289,28 @@ fs::file::file(const std::string& path, bs_t<open_mode> mode)
 			return nwritten_sum;
 		}
 
+		u64 read_at(u64 offset, void* buffer, u64 count) override
+		{
+			return overlapped_op(offset, static_cast<char*>(buffer), count, [](HANDLE handle, char* data, DWORD size, OVERLAPPED* ovl)
+			{
+				return ReadFile(handle, data, size, nullptr, ovl);
+			});
+		}
+
+		u64 write_at(u64 offset, const void* buffer, u64 count) override
+		{
+			if (!(m_access & GENERIC_WRITE))
+			{
+				g_tls_error = error::inval;
+				return -1;
+			}
+
+			return overlapped_op(offset, static_cast<const char*>(buffer), count, [](HANDLE handle, const char* data, DWORD size, OVERLAPPED* ovl)
+			{
+				return WriteFile(handle, data, size, nullptr, ovl);
+			});
+		}
+
 		u64 seek(s64 offset, seek_mode whence) override
 		{
 			if (whence > seek_end)
@@ -1238,7 +1348,7 @@ fs::file::file(const std::string& path, bs_t<open_mode> mode)
 		}
 	};
 
-	m_file = std::make_unique<windows_file>(handle);
+	m_file = std::make_unique<windows_file>(handle, access, share);
 #else
 	int flags = O_CLOEXEC; // Ensures all files are closed on execl for auto updater
 
@@ -1354,6 +1464,22 @@ fs::file::file(const std::string& path, bs_t<open_mode> mode)
 			return result;
 		}
 
+		u64 read_at(u64 offset, void* buffer, u64 count) override
+		{
+			const auto result = ::pread(m_fd, buffer, count, offset);
+			ensure(result != -1); // "file::read_at"
+
+			return result;
+		}
+
+		u64 write_at(u64 offset, const void* buffer, u64 count) override
+		{
+			const auto result = ::pwrite(m_fd, buffer, count, offset);
+			ensure(result != -1); // "file::write_at"
+
+			return result;
+		}
+
 		u64 seek(s64 offset, seek_mode whence) override
 		{
 			if (whence > seek_end)
@@ -1494,6 +1620,196 @@ fs::file::file(const void* ptr, usz size)
 	m_file = std::make_unique<memory_stream>(ptr, size);
 }
 
+fs::file_map::file_map(const file& f)
+{
+	if (!f)
+	{
+		g_tls_error = error::inval;
+		return;
+	}
+
+	const u64 size = f.size();
+
+	if (!size || size != static_cast<usz>(size))
+	{
+		// Empty files can't be mapped
+		g_tls_error = error::inval;
+		return;
+	}
+
+#ifdef _WIN32
+	const HANDLE handle = f.get_handle();
+
+	if (handle == INVALID_HANDLE_VALUE)
+	{
+		g_tls_error = error::inval;
+		return;
+	}
+
+	m_handle = CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+	if (!m_handle)
+	{
+		g_tls_error = to_error(GetLastError());
+		return;
+	}
+
+	m_ptr = static_cast<const u8*>(MapViewOfFile(m_handle, FILE_MAP_READ, 0, 0, 0));
+
+	if (!m_ptr)
+	{
+		g_tls_error = to_error(GetLastError());
+		CloseHandle(m_handle);
+		m_handle = nullptr;
+		return;
+	}
+#else
+	const int fd = f.get_handle();
+
+	if (fd == -1)
+	{
+		g_tls_error = error::inval;
+		return;
+	}
+
+	const auto ptr = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+
+	if (ptr == MAP_FAILED)
+	{
+		g_tls_error = to_error(errno);
+		return;
+	}
+
+	m_ptr = static_cast<const u8*>(ptr);
+#endif
+
+	m_size = size;
+}
+
+fs::file_map::file_map(file_map&& other) noexcept
+	: m_ptr(std::exchange(other.m_ptr, nullptr))
+	, m_size(std::exchange(other.m_size, 0))
+#ifdef _WIN32
+	, m_handle(std::exchange(other.m_handle, nullptr))
+#endif
+{
+}
+
+fs::file_map& fs::file_map::operator=(file_map&& other) noexcept
+{
+	if (this != &other)
+	{
+		this->~file_map();
+		new (this) file_map(std::move(other));
+	}
+
+	return *this;
+}
+
+fs::file_map::~file_map()
+{
+	if (!m_ptr)
+	{
+		return;
+	}
+
+#ifdef _WIN32
+	UnmapViewOfFile(m_ptr);
+	CloseHandle(m_handle);
+#else
+	::munmap(const_cast<u8*>(m_ptr), m_size);
+#endif
+}
+
+fs::file fs::make_mapped(const std::string& path)
+{
+	class mapped_stream final : public file_base
+	{
+		const file m_file;
+		const file_map m_map;
+		u64 m_pos{};
+
+	public:
+		mapped_stream(file&& f, file_map&& map)
+			: m_file(std::move(f))
+			, m_map(std::move(map))
+		{
+		}
+
+		stat_t stat() override
+		{
+			return m_file.stat();
+		}
+
+		bool trunc(u64) override
+		{
+			return false;
+		}
+
+		u64 read(void* buffer, u64 count) override
+		{
+			if (m_pos < m_map.size())
+			{
+				// Get readable size
+				if (const u64 result = std::min<u64>(count, m_map.size() - m_pos))
+				{
+					std::memcpy(buffer, m_map.data() + m_pos, result);
+					m_pos += result;
+					return result;
+				}
+			}
+
+			return 0;
+		}
+
+		u64 write(const void*, u64) override
+		{
+			return 0;
+		}
+
+		u64 seek(s64 offset, fs::seek_mode whence) override
+		{
+			const s64 new_pos =
+				whence == fs::seek_set ? offset :
+				whence == fs::seek_cur ? offset + m_pos :
+				whence == fs::seek_end ? offset + size() : -1;
+
+			if (new_pos < 0)
+			{
+				fs::g_tls_error = fs::error::inval;
+				return -1;
+			}
+
+			m_pos = new_pos;
+			return m_pos;
+		}
+
+		u64 size() override
+		{
+			return m_map.size();
+		}
+
+		native_handle get_handle() override
+		{
+			return m_file.get_handle();
+		}
+	};
+
+	file result(path, fs::read + fs::isfile);
+
+	if (!result || get_virtual_device(path))
+	{
+		return result;
+	}
+
+	if (file_map map{result})
+	{
+		result.reset(std::make_unique<mapped_stream>(std::move(result), std::move(map)));
+	}
+
+	return result;
+}
+
 fs::native_handle fs::file::get_handle() const
 {
 	if (m_file)
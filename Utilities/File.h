@@ -94,6 +94,8 @@ namespace fs
 		virtual u64 size() = 0;
 		virtual native_handle get_handle();
 		virtual u64 write_gather(const iovec_clone* buffers, u64 buf_count);
+		virtual u64 read_at(u64 offset, void* buffer, u64 size);
+		virtual u64 write_at(u64 offset, const void* buffer, u64 size);
 	};
 
 	// Directory entry (TODO)
@@ -306,6 +308,28 @@ namespace fs
 			return m_file->write(buffer, count);
 		}
 
+		// Read the data at the specified offset without using or moving the current position, returns -1 if not supported
+		u64 read_at(u64 offset, void* buffer, u64 count,
+			u32 line = __builtin_LINE(),
+			u32 col = __builtin_COLUMN(),
+			const char* file = __builtin_FILE(),
+			const char* func = __builtin_FUNCTION()) const
+		{
+			if (!m_file) xnull({line, col, file, func});
+			return m_file->read_at(offset, buffer, count);
+		}
+
+		// Write the data at the specified offset without using or moving the current position, returns -1 if not supported
+		u64 write_at(u64 offset, const void* buffer, u64 count,
+			u32 line = __builtin_LINE(),
+			u32 col = __builtin_COLUMN(),
+			const char* file = __builtin_FILE(),
+			const char* func = __builtin_FUNCTION()) const
+		{
+			if (!m_file) xnull({line, col, file, func});
+			return m_file->write_at(offset, buffer, count);
+		}
+
 		// Change current position, returns resulting position
 		u64 seek(s64 offset, seek_mode whence = seek_set,
 			u32 line = __builtin_LINE(),
@@ -493,6 +517,51 @@ namespace fs
 		}
 	};
 
+	// Read-only memory mapping of the whole file (pages are loaded on demand and shared with other mappings)
+	class file_map final
+	{
+		const u8* m_ptr = nullptr;
+		u64 m_size = 0;
+
+#ifdef _WIN32
+		void* m_handle = nullptr;
+#endif
+
+	public:
+		file_map() = default;
+
+		// Map opened file (must be a native file, the handle may be closed afterwards)
+		explicit file_map(const file& f);
+
+		file_map(const file_map&) = delete;
+
+		file_map& operator=(const file_map&) = delete;
+
+		file_map(file_map&& other) noexcept;
+
+		file_map& operator=(file_map&& other) noexcept;
+
+		~file_map();
+
+		explicit operator bool() const
+		{
+			return m_ptr != nullptr;
+		}
+
+		const u8* data() const
+		{
+			return m_ptr;
+		}
+
+		u64 size() const
+		{
+			return m_size;
+		}
+	};
+
+	// Open file for reading through the memory mapping (falls back to regular file access if not possible)
+	file make_mapped(const std::string& path);
+
 	class dir final
 	{
 		std::unique_ptr<dir_base> m_dir{};
@@ -931,11 +931,21 @@ void jit_compiler::add(std::unique_ptr<llvm::Module> _module)
 
 void jit_compiler::add(const std::string& path)
 {
-	auto cache = ObjectCache::load(path);
+	add(load(path), path);
+}
 
-	if (auto object_file = llvm::object::ObjectFile::createObjectFile(*cache))
+void jit_compiler::add(std::unique_ptr<llvm::MemoryBuffer> object, const std::string& path)
+{
+	if (!object)
 	{
-		m_engine->addObjectFile( std::move(*object_file) );
+		jit_log.error("ObjectCache: Adding failed (not loaded): %s", path);
+		return;
+	}
+
+	if (auto object_file = llvm::object::ObjectFile::createObjectFile(*object))
+	{
+		// Keep the buffer alive together with the object
+		m_engine->addObjectFile(llvm::object::OwningBinary<llvm::object::ObjectFile>(std::move(*object_file), std::move(object)));
 	}
 	else
 	{
@@ -943,6 +953,11 @@ void jit_compiler::add(const std::string& path)
 	}
 }
 
+std::unique_ptr<llvm::MemoryBuffer> jit_compiler::load(const std::string& path)
+{
+	return ObjectCache::load(path);
+}
+
 bool jit_compiler::check(const std::string& path)
 {
 	if (auto cache = ObjectCache::load(path))
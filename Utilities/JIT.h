@@ -321,6 +321,7 @@ namespace llvm
 	class LLVMContext;
 	class ExecutionEngine;
 	class Module;
+	class MemoryBuffer;
 }
 
 // Temporary compiler interface
@@ -359,6 +360,12 @@ public:
 	// Add object (path to obj file)
 	void add(const std::string& path);
 
+	// Add object (preloaded with load(), path is used for error reporting)
+	void add(std::unique_ptr<llvm::MemoryBuffer> object, const std::string& path);
+
+	// Load and decompress object file (path to obj file), can be used concurrently
+	static std::unique_ptr<llvm::MemoryBuffer> load(const std::string& path);
+
 	// Check object file
 	static bool check(const std::string& path);
 
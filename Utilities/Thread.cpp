@@ -6,6 +6,7 @@
 #include "Emu/Cell/lv2/sys_event.h"
 #include "Emu/RSX/RSXThread.h"
 #include "Thread.h"
+#include "StrUtil.h"
 #include "Utilities/JIT.h"
 #include <thread>
 #include <sstream>
@@ -2892,6 +2893,113 @@ u64 thread_ctrl::get_affinity_mask(thread_class group)
 	return -1;
 }
 
+const std::vector<u64>& thread_ctrl::get_cache_domains()
+{
+	static const std::vector<u64> domains = []()
+	{
+		std::vector<u64> result;
+
+		const auto add_domain = [&](u64 mask)
+		{
+			mask &= process_affinity_mask;
+
+			if (mask && std::find(result.begin(), result.end(), mask) == result.end())
+			{
+				result.push_back(mask);
+			}
+		};
+
+#ifdef _WIN32
+		DWORD buffer_size = 0;
+
+		if (!GetLogicalProcessorInformationEx(RelationCache, nullptr, &buffer_size) && GetLastError() == ERROR_INSUFFICIENT_BUFFER)
+		{
+			std::vector<u8> buffer(buffer_size);
+
+			if (GetLogicalProcessorInformationEx(RelationCache, reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data()), &buffer_size))
+			{
+				// Collect the processor masks of every L3 cache
+				for (uptr ptr = reinterpret_cast<uptr>(buffer.data()), end = ptr + buffer_size; ptr < end;)
+				{
+					const auto info = reinterpret_cast<const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(ptr);
+
+					if (info->Cache.Level == 3 && info->Cache.GroupMask.Group == 0)
+					{
+						add_domain(info->Cache.GroupMask.Mask);
+					}
+
+					ptr += info->Size;
+				}
+			}
+		}
+#elif defined(__linux__)
+		for (u32 cpu = 0; cpu < 64; cpu++)
+		{
+			if (!(process_affinity_mask & (1ull << cpu)))
+			{
+				continue;
+			}
+
+			// Format: comma-separated list of ranges, e.g. "0-5,12-17"
+			const fs::file list_file(fmt::format("/sys/devices/system/cpu/cpu%u/cache/index3/shared_cpu_list", cpu));
+
+			if (!list_file)
+			{
+				continue;
+			}
+
+			// Sysfs reports a fake file size, read up to the buffer size instead
+			std::string list(256, '\0');
+			list.resize(list_file.read(list.data(), list.size()));
+
+			u64 mask = 0;
+
+			for (const std::string& range : fmt::split(fmt::trim(list, " \t\n"), {","}))
+			{
+				u32 first = 0, last = 0;
+
+				const int count = std::sscanf(range.c_str(), "%u-%u", &first, &last);
+
+				if (count <= 0)
+				{
+					continue;
+				}
+
+				if (count == 1)
+				{
+					last = first;
+				}
+
+				for (u32 i = first; i <= last && i < 64; i++)
+				{
+					mask |= 1ull << i;
+				}
+			}
+
+			add_domain(mask);
+		}
+#endif
+
+		if (result.empty())
+		{
+			// Unknown topology, assume a single domain
+			result.push_back(process_affinity_mask);
+		}
+
+		std::string layout;
+
+		for (u64 mask : result)
+		{
+			fmt::append(layout, "%s0x%x", layout.empty() ? "" : ", ", mask);
+		}
+
+		sig_log.notice("Detected %u host cache domain(s): %s", result.size(), layout);
+		return result;
+	}();
+
+	return domains;
+}
+
 void thread_ctrl::set_native_priority(int priority)
 {
 #ifdef _WIN32
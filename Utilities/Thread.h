@@ -5,6 +5,7 @@
 #include "util/shared_ptr.hpp"
 
 #include <string>
+#include <vector>
 
 #include "mutex.h"
 #include "lockless.h"
@@ -314,6 +315,9 @@ public:
 	// Returns a core affinity mask. Set whether to generate the high priority set or not
 	static u64 get_affinity_mask(thread_class group);
 
+	// Returns affinity masks of host cache domains (groups of cores sharing the last level cache)
+	static const std::vector<u64>& get_cache_domains();
+
 	// Sets the native thread priority
 	static void set_native_priority(int priority);
 
@@ -2,15 +2,192 @@
 #include "decrypt_binaries.h"
 #include "unedat.h"
 #include "unself.h"
+#include "sha1.h"
 #include "Emu/IdManager.h"
 #include "Emu/System.h"
 #include "Utilities/StrUtil.h"
+#include "Utilities/Thread.h"
+#include "util/sysinfo.hpp"
 
 #include <charconv>
 #include <iostream>
+#include <unordered_map>
 
 LOG_CHANNEL(dec_log, "DECRYPT");
 
+namespace
+{
+	// Previously decrypted files: output path -> (source file hash, output size)
+	struct decrypt_cache
+	{
+		const std::string path = fs::get_cache_dir() + "decrypted.txt";
+
+		std::unordered_map<std::string, std::pair<std::string, u64>> entries;
+
+		shared_mutex mutex;
+
+		bool dirty = false;
+
+		void load()
+		{
+			const fs::file file(path);
+
+			if (!file)
+			{
+				return;
+			}
+
+			// Each line: <hash> <size> <path>
+			for (const std::string& line : fmt::split(file.to_string(), {"\n"}))
+			{
+				const usz pos0 = line.find(' ');
+				const usz pos1 = pos0 == umax ? umax : line.find(' ', pos0 + 1);
+
+				if (pos1 == umax)
+				{
+					continue;
+				}
+
+				u64 size = 0;
+
+				if (std::from_chars(line.data() + pos0 + 1, line.data() + pos1, size).ec != std::errc{})
+				{
+					continue;
+				}
+
+				entries[line.substr(pos1 + 1)] = {line.substr(0, pos0), size};
+			}
+		}
+
+		void save()
+		{
+			if (!dirty)
+			{
+				return;
+			}
+
+			std::string data;
+
+			for (const auto& [out_path, entry] : entries)
+			{
+				fmt::append(data, "%s %u %s\n", entry.first, entry.second, out_path);
+			}
+
+			fs::pending_file file(path);
+
+			if (!file.file || (file.file.write(data), !file.commit()))
+			{
+				dec_log.error("Failed to save %s (%s)", path, fs::g_tls_error);
+			}
+		}
+
+		// Check if the output exists and has been created from the same source
+		bool is_cached(const std::string& out_path, const std::string& hash)
+		{
+			reader_lock lock(mutex);
+
+			const auto found = entries.find(out_path);
+
+			if (found == entries.end() || found->second.first != hash)
+			{
+				return false;
+			}
+
+			fs::stat_t stat{};
+			return fs::stat(out_path, stat) && !stat.is_directory && stat.size == found->second.second;
+		}
+
+		void add(const std::string& out_path, const std::string& hash, u64 size)
+		{
+			std::lock_guard lock(mutex);
+			entries[out_path] = {hash, size};
+			dirty = true;
+		}
+	};
+}
+
+static std::string get_file_hash(const fs::file& file)
+{
+	sha1_context ctx;
+	sha1_starts(&ctx);
+
+	std::vector<u8> buf(0x100000);
+
+	file.seek(0);
+
+	while (const u64 size = file.read(buf.data(), buf.size()))
+	{
+		sha1_update(&ctx, buf.data(), size);
+	}
+
+	u8 output[20];
+	sha1_finish(&ctx, output);
+
+	std::string result;
+
+	for (u8 v : output)
+	{
+		fmt::append(result, "%02x", v);
+	}
+
+	return result;
+}
+
+// Try to decrypt the module with the keys starting from key_it, returns the size of the output file (0 on failure)
+static u64 decrypt_module(const std::string& old_path, const std::string& new_path, u32 file_magic, const std::vector<u128>& klics, usz key_it)
+{
+	for (; key_it < klics.size(); key_it++)
+	{
+		// Local copy of the key (shared between the workers)
+		u128 key = klics[key_it];
+
+		// First KLIC is no KLIC
+		u8* const klic = key_it != 0 ? reinterpret_cast<u8*>(&key) : nullptr;
+
+		if (file_magic == "SCE\0"_u32)
+		{
+			// Segments are decompressed directly into the output file
+			if (const fs::file out = decrypt_self_to_file(fs::make_mapped(old_path), new_path, klic))
+			{
+				return out.size();
+			}
+
+			// Try another key
+			continue;
+		}
+
+		// EDAT / SDAT
+		const fs::file elf_file = DecryptEDAT(fs::make_mapped(old_path), old_path, key_it != 0 ? 8 : 1, reinterpret_cast<u8*>(&key), true);
+
+		if (!elf_file)
+		{
+			// Try another key
+			continue;
+		}
+
+		fs::file new_file(new_path, fs::rewrite);
+
+		if (!new_file)
+		{
+			dec_log.error("Failed to create %s (%s)", new_path, fs::g_tls_error);
+			return 0;
+		}
+
+		std::vector<u8> buf(0x100000);
+
+		elf_file.seek(0);
+
+		while (const u64 size = elf_file.read(buf.data(), buf.size()))
+		{
+			new_file.write(buf.data(), size);
+		}
+
+		return new_file.size();
+	}
+
+	return 0;
+}
+
 void decrypt_sprx_libraries(std::vector<std::string> modules, std::function<std::string(std::string old_path, std::string path, bool tried)> input_cb)
 {
 	if (modules.empty())
@@ -37,129 +214,140 @@ void decrypt_sprx_libraries(std::vector<std::string> modules, std::function<std:
 	// Try to use the key that has been for the current running ELF
 	klics.insert(klics.end(), Emu.klic.begin(), Emu.klic.end());
 
-	for (const std::string& _module : modules)
+	decrypt_cache cache;
+	cache.load();
+
+	// Serializes the CLI output of the workers
+	std::mutex cout_mutex;
+
+	const auto report = [&](const std::string& text)
 	{
-		const std::string old_path = _module;
+		std::lock_guard lock(cout_mutex);
+		std::cout << text << std::endl; // For CLI
+	};
 
-		fs::file elf_file;
+	struct module_info
+	{
+		std::string new_path;
+		std::string hash;
+		u32 file_magic = 0;
+		bool pending = false;
+	};
 
-		bool tried = false;
-		bool invalid = false;
-		usz key_it = 0;
-		u32 file_magic{};
+	std::vector<module_info> infos(modules.size());
 
-		while (true)
+	atomic_t<usz> next = 0;
+
+	// First pass: decrypt all modules in parallel with the known keys
+	named_thread_group workers("SPRX Decrypter ", std::min<u32>(utils::get_thread_count(), ::size32(modules)), [&]()
+	{
+		for (usz i = next++; i < modules.size(); i = next++)
 		{
-			for (; key_it < klics.size(); key_it++)
+			const std::string& old_path = modules[i];
+			module_info& info = infos[i];
+
+			const fs::file elf_file = fs::make_mapped(old_path);
+
+			if (!elf_file || !elf_file.read(info.file_magic) || (info.file_magic != "SCE\0"_u32 && info.file_magic != "NPD\0"_u32))
 			{
-				if (!elf_file.open(old_path) || !elf_file.read(file_magic))
-				{
-					file_magic = 0;
-				}
+				dec_log.error("Failed to decrypt \"%s\".", old_path);
+				report(fmt::format("Failed to decrypt \"%s\".", old_path));
+				continue;
+			}
 
-				switch (file_magic)
-				{
-				case "SCE\0"_u32:
-				{
-					// First KLIC is no KLIC
-					elf_file = decrypt_self(std::move(elf_file), key_it != 0 ? reinterpret_cast<u8*>(&klics[key_it]) : nullptr);
+			const std::string exec_ext = fmt::to_lower(old_path).ends_with(".sprx") ? ".prx" : ".elf";
+			info.new_path = info.file_magic == "NPD\0"_u32 ? old_path + ".unedat" :
+				old_path.substr(0, old_path.find_last_of('.')) + exec_ext;
 
-					if (!elf_file)
-					{
-						// Try another key
-						continue;
-					}
+			info.hash = get_file_hash(elf_file);
 
-					break;
-				}
-				case "NPD\0"_u32:
-				{
-					// EDAT / SDAT
-					elf_file = DecryptEDAT(elf_file, old_path, key_it != 0 ? 8 : 1, reinterpret_cast<u8*>(&klics[key_it]), true);
+			if (cache.is_cached(info.new_path, info.hash))
+			{
+				dec_log.success("Skipped %s (already decrypted to %s)", old_path, info.new_path);
+				report(fmt::format("Skipped %s (already decrypted to %s)", old_path, info.new_path));
+				continue;
+			}
 
-					if (!elf_file)
-					{
-						// Try another key
-						continue;
-					}
+			if (const u64 size = decrypt_module(old_path, info.new_path, info.file_magic, klics, 0))
+			{
+				cache.add(info.new_path, info.hash, size);
+				dec_log.success("Decrypted %s -> %s", old_path, info.new_path);
+				report(fmt::format("Decrypted %s -> %s", old_path, info.new_path));
+				continue;
+			}
 
-					break;
-				}
-				default:
-				{
-					invalid = true;
-					break;
-				}
-				}
+			// Requires user input
+			info.pending = true;
+		}
+	});
 
-				if (invalid)
-				{
-					elf_file.close();
-				}
+	workers.join();
 
-				break;
-			}
+	// Second pass: allow the user to manually type KLIC for the modules which failed
+	const usz known_klics = klics.size();
 
-			if (elf_file)
-			{
-				const std::string exec_ext = fmt::to_lower(_module).ends_with(".sprx") ? ".prx" : ".elf";
-				const std::string new_path = file_magic == "NPD\0"_u32 ? old_path + ".unedat" :
-					old_path.substr(0, old_path.find_last_of('.')) + exec_ext;
+	for (usz i = 0; i < modules.size(); i++)
+	{
+		if (!infos[i].pending)
+		{
+			continue;
+		}
 
-				if (fs::file new_file{new_path, fs::rewrite})
-				{
-					new_file.write(elf_file.to_string());
-					dec_log.success("Decrypted %s -> %s", old_path, new_path);
-					std::cout << "Decrypted " << old_path << " -> " << new_path << std::endl; // For CLI
-				}
-				else
-				{
-					dec_log.error("Failed to create %s", new_path);
-					std::cout << "Failed to create " << new_path << std::endl; // For CLI
-				}
+		const std::string& old_path = modules[i];
+		const module_info& info = infos[i];
 
-				break;
-			}
+		// Try the keys entered for the previous modules first
+		usz key_it = known_klics;
+		bool tried = false;
 
-			if (!invalid)
+		while (true)
+		{
+			if (const u64 size = decrypt_module(old_path, info.new_path, info.file_magic, klics, key_it))
 			{
-				// Allow the user to manually type KLIC if decryption failed
+				cache.add(info.new_path, info.hash, size);
+				dec_log.success("Decrypted %s -> %s", old_path, info.new_path);
+				report(fmt::format("Decrypted %s -> %s", old_path, info.new_path));
+				break;
+			}
 
-				const std::string filename = old_path.substr(old_path.find_last_of(fs::delim) + 1);
-				const std::string text = input_cb ? input_cb(old_path, filename, tried) : "";
+			key_it = klics.size();
 
-				if (!text.empty())
-				{
-					auto& klic = (tried ? klics.back() : klics.emplace_back());
+			const std::string filename = old_path.substr(old_path.find_last_of(fs::delim) + 1);
+			const std::string text = input_cb ? input_cb(old_path, filename, tried) : "";
 
-					ensure(text.size() == 32);
+			if (!text.empty())
+			{
+				auto& klic = (tried ? klics.back() : klics.emplace_back());
 
-					// It must succeed (only hex characters are present)
-					u64 lo_ = 0;
-					u64 hi_ = 0;
-					std::from_chars(&text[0], &text[16], lo_, 16);
-					std::from_chars(&text[16], &text[32], hi_, 16);
+				ensure(text.size() == 32);
 
-					be_t<u64> lo = std::bit_cast<be_t<u64>>(lo_);
-					be_t<u64> hi = std::bit_cast<be_t<u64>>(hi_);
+				// It must succeed (only hex characters are present)
+				u64 lo_ = 0;
+				u64 hi_ = 0;
+				std::from_chars(&text[0], &text[16], lo_, 16);
+				std::from_chars(&text[16], &text[32], hi_, 16);
 
-					klic = (u128{+hi} << 64) | +lo;
+				be_t<u64> lo = std::bit_cast<be_t<u64>>(lo_);
+				be_t<u64> hi = std::bit_cast<be_t<u64>>(hi_);
 
-					// Retry with specified KLIC
-					key_it -= +std::exchange(tried, true); // Rewind on second and above attempt
-					dec_log.notice("KLIC entered for %s: %s", filename, klic);
-					continue;
-				}
+				klic = (u128{+hi} << 64) | +lo;
 
-				dec_log.notice("User has cancelled entering KLIC.");
+				// Retry with specified KLIC
+				key_it = klics.size() - 1;
+				tried = true;
+				dec_log.notice("KLIC entered for %s: %s", filename, klic);
+				continue;
 			}
 
+			dec_log.notice("User has cancelled entering KLIC.");
 			dec_log.error("Failed to decrypt \"%s\".", old_path);
-			std::cout << "Failed to decrypt \"" << old_path << "\"." << std::endl; // For CLI
+			report(fmt::format("Failed to decrypt \"%s\".", old_path));
 			break;
 		}
 	}
 
+	cache.save();
+
 	dec_log.notice("Finished decrypting all binaries.");
 	std::cout << "Finished decrypting all binaries." << std::endl; // For CLI
 }
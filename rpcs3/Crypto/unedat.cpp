@@ -947,6 +947,42 @@ bool EDATADecrypter::ReadHeader()
 	return true;
 }
 
+const EDATADecrypter::block_cache_entry* EDATADecrypter::GetBlock(u32 block)
+{
+	block_cache_entry* lru = &block_cache[0];
+
+	for (auto& entry : block_cache)
+	{
+		if (entry.block == block)
+		{
+			entry.last_use = ++cache_tick;
+			return &entry;
+		}
+
+		if (entry.last_use < lru->last_use)
+		{
+			lru = &entry;
+		}
+	}
+
+	// Decrypt into the least recently used entry
+	lru->block = umax;
+	lru->data.resize(edatHeader.block_size);
+
+	edata_file.seek(0);
+	const u64 res = decrypt_block(&edata_file, lru->data.data(), &edatHeader, &npdHeader, reinterpret_cast<uchar*>(&dec_key), block, total_blocks, edatHeader.file_size);
+
+	if (res == umax)
+	{
+		return nullptr;
+	}
+
+	lru->block = block;
+	lru->size = res;
+	lru->last_use = ++cache_tick;
+	return lru;
+}
+
 u64 EDATADecrypter::ReadData(u64 pos, u8* data, u64 size)
 {
 	size = std::min<u64>(size, pos > edatHeader.file_size ? 0 : edatHeader.file_size - pos);
@@ -957,31 +993,35 @@ u64 EDATADecrypter::ReadData(u64 pos, u8* data, u64 size)
 	}
 
 	// Now we need to offset things to account for the actual 'range' requested
-	const u64 startOffset = pos % edatHeader.block_size;
+	u64 startOffset = pos % edatHeader.block_size;
 
 	const u64 num_blocks = utils::aligned_div(startOffset + size, edatHeader.block_size);
-	data_buf.resize(num_blocks * edatHeader.block_size);
 
 	// Find and decrypt block range covering pos + size
 	const u32 starting_block = ::narrow<u32>(pos / edatHeader.block_size);
 	const u32 ending_block = ::narrow<u32>(std::min<u64>(starting_block + num_blocks, total_blocks));
-	u64 writeOffset = 0;
+	u64 bytesWrote = 0;
 
-	for (u32 i = starting_block; i < ending_block; ++i)
+	for (u32 i = starting_block; i < ending_block && bytesWrote < size; ++i)
 	{
-		edata_file.seek(0);
-		u64 res = decrypt_block(&edata_file, &data_buf[writeOffset], &edatHeader, &npdHeader, reinterpret_cast<uchar*>(&dec_key), i, total_blocks, edatHeader.file_size);
-		if (res == umax)
+		const auto block = GetBlock(i);
+
+		if (!block)
 		{
 			edat_log.error("Error Decrypting data");
 			return 0;
 		}
 
-		writeOffset += res;
-	}
+		if (block->size <= startOffset)
+		{
+			break;
+		}
 
-	const u64 bytesWrote = std::min<u64>(writeOffset - startOffset, size);
+		const u64 count = std::min<u64>(block->size - startOffset, size - bytesWrote);
+		std::memcpy(data + bytesWrote, block->data.data() + startOffset, count);
+		bytesWrote += count;
+		startOffset = 0;
+	}
 
-	memcpy(data, &data_buf[startOffset], bytesWrote);
 	return bytesWrote;
 }
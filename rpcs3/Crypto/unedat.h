@@ -73,11 +73,24 @@ struct EDATADecrypter final : fs::file_base
 	NPD_HEADER npdHeader{};
 	EDAT_HEADER edatHeader{};
 
-	// Internal data buffers.
-	std::vector<u8> data_buf{};
+	// Decrypted block cache entry
+	struct block_cache_entry
+	{
+		u32 block = umax;
+		u64 size = 0;
+		u64 last_use = 0;
+		std::vector<u8> data{};
+	};
+
+	// Small LRU cache of decrypted blocks (small reads often hit the same block)
+	std::array<block_cache_entry, 8> block_cache{};
+	u64 cache_tick = 0;
 
 	u128 dec_key{};
 
+	// Get decrypted block data (nullptr on error)
+	const block_cache_entry* GetBlock(u32 block);
+
 public:
 	EDATADecrypter(fs::file&& input, u128 dec_key = {})
 		: edata_file(std::move(input))
@@ -9,6 +9,10 @@
 #include "Emu/VFS.h"
 #include "unpkg.h"
 #include "Loader/PSF.h"
+#include "util/sysinfo.hpp"
+#include "Utilities/Thread.h"
+
+#include <deque>
 
 LOG_CHANNEL(pkg_log, "PKG");
 
@@ -129,46 +133,12 @@ bool package_reader::read_header()
 	}
 	}
 
-	if (m_header.pkg_size > m_file.size())
-	{
-		// Check if multi-files pkg
-		if (!m_path.ends_with("_00.pkg"))
-		{
-			pkg_log.error("PKG file size mismatch (pkg_size=0x%llx)", m_header.pkg_size);
-			return false;
-		}
-
-		std::vector<fs::file> filelist;
-		filelist.emplace_back(std::move(m_file));
-
-		const std::string name_wo_number = m_path.substr(0, m_path.size() - 7);
-		u64 cursize = filelist[0].size();
-
-		while (cursize < m_header.pkg_size)
-		{
-			const std::string archive_filename = fmt::format("%s_%02d.pkg", name_wo_number, filelist.size());
-
-			fs::file archive_file(archive_filename);
-			if (!archive_file)
-			{
-				pkg_log.error("Missing part of the multi-files pkg: %s", archive_filename);
-				return false;
-			}
-
-			const usz add_size = archive_file.size();
+	// Check if multi-files pkg
+	m_file = open_package(std::move(m_file));
 
-			if (!add_size)
-			{
-				pkg_log.error("%s is empty, cannot read PKG", archive_filename);
-				return false;
-			}
-
-			cursize += add_size;
-			filelist.emplace_back(std::move(archive_file));
-		}
-
-		// Gather files
-		m_file = fs::make_gather(std::move(filelist));
+	if (!m_file)
+	{
+		return false;
 	}
 
 	if (m_header.data_size + m_header.data_offset > m_header.pkg_size)
@@ -743,12 +713,30 @@ bool package_reader::extract_data(atomic_t<double>& sync)
 		return false;
 	}
 
-	usz num_failures = 0;
+	atomic_t<usz> num_failures = 0;
 
 	std::vector<PKGEntry> entries(m_header.file_count);
 
 	std::memcpy(entries.data(), m_buf.get(), entries.size() * sizeof(PKGEntry));
 
+	// Files to extract (directories are created immediately)
+	struct file_job
+	{
+		std::string name;
+		std::string path;
+		const PKGEntry* entry;
+		bool did_overwrite;
+		bool is_buffered;
+		atomic_t<u64> chunks_left;
+		atomic_t<bool> failed;
+
+		// Output file, opened by the first chunk and closed with the last one
+		shared_mutex mutex;
+		fs::file out;
+	};
+
+	std::deque<file_job> jobs;
+
 	for (const auto& entry : entries)
 	{
 		if (entry.name_size > 256)
@@ -801,75 +789,26 @@ bool package_reader::extract_data(atomic_t<double>& sync)
 				pkg_log.todo("NPDRM EDAT!");
 			}
 
-			if (fs::file out = is_buffered ? fs::make_stream<std::vector<u8>>() : fs::file{ path, fs::rewrite })
+			if (!is_buffered)
 			{
-				bool extract_success = true;
-				for (u64 pos = 0; pos < entry.file_size; pos += BUF_SIZE)
-				{
-					const u64 block_size = std::min<u64>(BUF_SIZE, entry.file_size - pos);
-
-					if (decrypt(entry.file_offset + pos, block_size, is_psp ? PKG_AES_KEY2 : m_dec_key.data()) != block_size)
-					{
-						extract_success = false;
-						pkg_log.error("Failed to extract file %s", path);
-						break;
-					}
-
-					if (out.write(m_buf.get(), block_size) != block_size)
-					{
-						extract_success = false;
-						pkg_log.error("Failed to write file %s", path);
-						break;
-					}
+				// Create the file with its final size, the chunks are written in any order
+				fs::file out{path, fs::rewrite};
 
-					if (sync.fetch_add((block_size + 0.0) / m_header.data_size) < 0.)
-					{
-						if (was_null)
-						{
-							pkg_log.error("Package installation cancelled: %s", dir);
-							out.close();
-							fs::remove_all(dir, true);
-							return false;
-						}
-
-						// Cannot cancel the installation
-						sync += 1.;
-					}
-				}
-
-				if (is_buffered)
-				{
-					out = DecryptEDAT(out, name, 1, reinterpret_cast<u8*>(&m_header.klicensee), true);
-					if (!out || !fs::write_file(path, fs::rewrite, static_cast<fs::container_stream<std::vector<u8>>*>(out.release().get())->obj))
-					{
-						num_failures++;
-						pkg_log.error("Failed to create file %s", path);
-						break;
-					}
-				}
-
-				if (extract_success)
-				{
-					if (did_overwrite)
-					{
-						pkg_log.warning("Overwritten file %s", path);
-					}
-					else
-					{
-						pkg_log.notice("Created file %s", path);
-					}
-				}
-				else
+				if (!out || !out.trunc(entry.file_size))
 				{
 					num_failures++;
+					pkg_log.error("Failed to create file %s", path);
+					break;
 				}
 			}
-			else
-			{
-				num_failures++;
-				pkg_log.error("Failed to create file %s", path);
-			}
 
+			auto& job = jobs.emplace_back();
+			job.name = name;
+			job.path = path;
+			job.entry = &entry;
+			job.did_overwrite = did_overwrite;
+			job.is_buffered = is_buffered;
+			job.chunks_left = is_buffered ? 1 : std::max<u64>(1, (entry.file_size + BUF_SIZE - 1) / BUF_SIZE);
 			break;
 		}
 
@@ -901,6 +840,169 @@ bool package_reader::extract_data(atomic_t<double>& sync)
 		}
 	}
 
+	// Split files into chunks, decrypted and written in parallel (AES-CTR keystream is seekable)
+	std::vector<std::pair<file_job*, u64>> chunks;
+
+	for (auto& job : jobs)
+	{
+		for (u64 i = 0, count = job.chunks_left; i < count; i++)
+		{
+			chunks.emplace_back(&job, i * BUF_SIZE);
+		}
+	}
+
+	// Write at the offset of the shared output file
+	auto write_chunk = [](file_job& job, u64 pos, const void* data, u64 size)
+	{
+		{
+			std::lock_guard lock(job.mutex);
+
+			if (!job.out && !job.out.open(job.path, fs::write))
+			{
+				return false;
+			}
+		}
+
+		if (const u64 written = job.out.write_at(pos, data, size); written != umax)
+		{
+			return written == size;
+		}
+
+		// No positional write support
+		std::lock_guard lock(job.mutex);
+		return job.out.seek(pos) == pos && job.out.write(data, size) == size;
+	};
+
+	auto finish_job = [&](file_job& job)
+	{
+		job.out.close();
+
+		if (job.failed)
+		{
+			num_failures++;
+		}
+		else if (job.did_overwrite)
+		{
+			pkg_log.warning("Overwritten file %s", job.path);
+		}
+		else
+		{
+			pkg_log.notice("Created file %s", job.path);
+		}
+	};
+
+	atomic_t<usz> next_chunk = 0;
+	atomic_t<bool> cancelled = false;
+	atomic_t<bool> cancel_ignored = false;
+
+	named_thread_group workers("PKG Worker ", std::min<u32>({utils::get_thread_count(), 8u, std::max<u32>(::size32(chunks), 1)}), [&]()
+	{
+		// Own file handle (of all parts) and buffer for every worker
+		const fs::file pkg = open_package(fs::file{m_path});
+		std::unique_ptr<u128[]> buf;
+
+		for (usz i = next_chunk++; i < chunks.size() && !cancelled; i = next_chunk++)
+		{
+			auto& [job, pos] = chunks[i];
+			const PKGEntry& entry = *job->entry;
+			const uchar* key = (entry.type & PKG_FILE_ENTRY_PSP) ? PKG_AES_KEY2 : m_dec_key.data();
+
+			if (job->is_buffered)
+			{
+				// Whole file is decrypted to memory and converted from SDAT
+				fs::file out = fs::make_stream<std::vector<u8>>();
+
+				if (!buf)
+				{
+					buf.reset(new u128[BUF_SIZE / sizeof(u128)]);
+				}
+
+				for (u64 off = 0; off < entry.file_size && !job->failed; off += BUF_SIZE)
+				{
+					const u64 block_size = std::min<u64>(BUF_SIZE, entry.file_size - off);
+
+					if (decrypt(pkg, entry.file_offset + off, block_size, key, buf.get()) != block_size)
+					{
+						job->failed = true;
+						pkg_log.error("Failed to extract file %s", job->path);
+					}
+					else
+					{
+						out.write(buf.get(), block_size);
+					}
+				}
+
+				if (!job->failed)
+				{
+					out = DecryptEDAT(out, job->name, 1, reinterpret_cast<u8*>(&m_header.klicensee), true);
+
+					if (!out || !fs::write_file(job->path, fs::rewrite, static_cast<fs::container_stream<std::vector<u8>>*>(out.release().get())->obj))
+					{
+						job->failed = true;
+						pkg_log.error("Failed to create file %s", job->path);
+					}
+				}
+			}
+			else if (!job->failed && entry.file_size)
+			{
+				if (!buf)
+				{
+					buf.reset(new u128[BUF_SIZE / sizeof(u128)]);
+				}
+
+				const u64 block_size = std::min<u64>(BUF_SIZE, entry.file_size - pos);
+
+				if (decrypt(pkg, entry.file_offset + pos, block_size, key, buf.get()) != block_size)
+				{
+					job->failed = true;
+					pkg_log.error("Failed to extract file %s", job->path);
+				}
+				else if (!write_chunk(*job, pos, buf.get(), block_size))
+				{
+					job->failed = true;
+					pkg_log.error("Failed to write file %s", job->path);
+				}
+			}
+
+			const u64 done = job->is_buffered ? entry.file_size.value() : std::min<u64>(BUF_SIZE, entry.file_size - pos);
+
+			if (sync.fetch_add((done + 0.0) / m_header.data_size) < 0.)
+			{
+				if (was_null)
+				{
+					cancelled = true;
+					break;
+				}
+
+				// Cannot cancel the installation
+				if (!cancel_ignored.exchange(true))
+				{
+					sync += 1.;
+				}
+			}
+
+			if (--job->chunks_left == 0)
+			{
+				finish_job(*job);
+			}
+		}
+	});
+
+	workers.join();
+
+	// Release the output files of unfinished jobs
+	for (auto& job : jobs)
+	{
+		job.out.close();
+	}
+
+	if (cancelled)
+	{
+		pkg_log.error("Package installation cancelled: %s", dir);
+		fs::remove_all(dir, true);
+		return false;
+	}
+
 	if (num_failures == 0)
 	{
 		pkg_log.success("Package successfully installed to %s", dir);
@@ -914,6 +1016,52 @@ bool package_reader::extract_data(atomic_t<double>& sync)
 	return num_failures == 0;
 }
 
+fs::file package_reader::open_package(fs::file file) const
+{
+	if (!file || m_header.pkg_size <= file.size())
+	{
+		return file;
+	}
+
+	if (!m_path.ends_with("_00.pkg"))
+	{
+		pkg_log.error("PKG file size mismatch (pkg_size=0x%llx)", m_header.pkg_size);
+		return {};
+	}
+
+	std::vector<fs::file> filelist;
+	filelist.emplace_back(std::move(file));
+
+	const std::string name_wo_number = m_path.substr(0, m_path.size() - 7);
+	u64 cursize = filelist[0].size();
+
+	while (cursize < m_header.pkg_size)
+	{
+		const std::string archive_filename = fmt::format("%s_%02d.pkg", name_wo_number, filelist.size());
+
+		fs::file archive_file(archive_filename);
+		if (!archive_file)
+		{
+			pkg_log.error("Missing part of the multi-files pkg: %s", archive_filename);
+			return {};
+		}
+
+		const usz add_size = archive_file.size();
+
+		if (!add_size)
+		{
+			pkg_log.error("%s is empty, cannot read PKG", archive_filename);
+			return {};
+		}
+
+		cursize += add_size;
+		filelist.emplace_back(std::move(archive_file));
+	}
+
+	// Gather files
+	return fs::make_gather(std::move(filelist));
+}
+
 void package_reader::archive_seek(const s64 new_offset, const fs::seek_mode damode)
 {
 	if (m_file) m_file.seek(new_offset, damode);
@@ -937,10 +1085,20 @@ u64 package_reader::decrypt(u64 offset, u64 size, const uchar* key)
 		m_buf.reset(new u128[std::max<u64>(BUF_SIZE, sizeof(PKGEntry) * m_header.file_count) / sizeof(u128)]);
 	}
 
-	archive_seek(m_header.data_offset + offset);
+	return decrypt(m_file, offset, size, key, m_buf.get());
+}
+
+u64 package_reader::decrypt(const fs::file& file, u64 offset, u64 size, const uchar* key, u128* buf) const
+{
+	if (!m_is_valid || !file)
+	{
+		return 0;
+	}
+
+	file.seek(m_header.data_offset + offset);
 
 	// Read the data and set available size
-	const u64 read = archive_read(m_buf.get(), size);
+	const u64 read = file.read(buf, size);
 
 	// Get block count
 	const u64 blocks = (read + 15) / 16;
@@ -969,7 +1127,7 @@ u64 package_reader::decrypt(u64 offset, u64 size, const uchar* key)
 
 			sha1(reinterpret_cast<const u8*>(input), sizeof(input), hash.data);
 
-			m_buf[i] ^= hash._v128;
+			buf[i] ^= hash._v128;
 		}
 	}
 	else if (m_header.pkg_type == PKG_RELEASE_TYPE_RELEASE)
@@ -989,7 +1147,7 @@ u64 package_reader::decrypt(u64 offset, u64 size, const uchar* key)
 
 			aes_crypt_ecb(&ctx, AES_ENCRYPT, reinterpret_cast<const u8*>(&input), reinterpret_cast<u8*>(&key));
 
-			m_buf[i] ^= key;
+			buf[i] ^= key;
 		}
 	}
 	else
@@ -999,4 +1157,4 @@ u64 package_reader::decrypt(u64 offset, u64 size, const uchar* key)
 
 	// Return the amount of data written in buf
 	return read;
-};
+}
@@ -321,6 +321,12 @@ private:
 	u64 archive_read(void* data_ptr, const u64 num_bytes);
 	u64 decrypt(u64 offset, u64 size, const uchar* key);
 
+	// Thread-safe variant: read with the given file handle and decrypt into the given buffer
+	u64 decrypt(const fs::file& file, u64 offset, u64 size, const uchar* key, u128* buf) const;
+
+	// Append the other parts of a split package (*_00.pkg, *_01.pkg, ...) to its first part
+	fs::file open_package(fs::file file) const;
+
 	const usz BUF_SIZE = 8192 * 1024; // 8 MB
 
 	bool m_is_valid = false;
@@ -1280,6 +1280,13 @@ fs::file SELFDecrypter::MakeElf(bool isElf32)
 	// Create a new ELF file.
 	fs::file e = fs::make_stream<std::vector<u8>>();
 
+	MakeElf(isElf32, e);
+
+	return e;
+}
+
+void SELFDecrypter::MakeElf(bool isElf32, fs::file& e)
+{
 	if (isElf32)
 	{
 		WriteElf(e, elf32_hdr, shdr32_arr, phdr32_arr);
@@ -1288,8 +1295,6 @@ fs::file SELFDecrypter::MakeElf(bool isElf32)
 	{
 		WriteElf(e, elf64_hdr, shdr64_arr, phdr64_arr);
 	}
-
-	return e;
 }
 
 bool SELFDecrypter::GetKeyFromRap(const char* content_id, u8* npdrm_key)
@@ -1460,6 +1465,73 @@ fs::file decrypt_self(fs::file elf_or_self, u8* klic_key, SelfAdditionalInfo* ou
 	return elf_or_self;
 }
 
+fs::file decrypt_self_to_file(fs::file elf_or_self, const std::string& path, u8* klic_key)
+{
+	if (!elf_or_self)
+	{
+		return fs::file{};
+	}
+
+	elf_or_self.seek(0);
+
+	if (elf_or_self.size() >= 4 && elf_or_self.read<u32>() == "SCE\0"_u32 && !CheckDebugSelf(elf_or_self))
+	{
+		const bool isElf32 = IsSelfElf32(elf_or_self);
+
+		SELFDecrypter self_dec(elf_or_self);
+
+		if (!self_dec.LoadHeaders(isElf32))
+		{
+			self_log.error("Failed to load SELF file headers!");
+			return fs::file{};
+		}
+
+		if (!self_dec.LoadMetadata(klic_key))
+		{
+			self_log.error("Failed to load SELF file metadata!");
+			return fs::file{};
+		}
+
+		if (!self_dec.DecryptData())
+		{
+			self_log.error("Failed to decrypt SELF file data!");
+			return fs::file{};
+		}
+
+		// Only create the output after successful decryption, segments are written as they are decompressed
+		fs::file out(path, fs::rewrite);
+
+		if (!out)
+		{
+			self_log.error("Failed to create %s (%s)", path, fs::g_tls_error);
+			return fs::file{};
+		}
+
+		self_dec.MakeElf(isElf32, out);
+		return out;
+	}
+
+	fs::file out(path, fs::rewrite);
+
+	if (!out)
+	{
+		self_log.error("Failed to create %s (%s)", path, fs::g_tls_error);
+		return fs::file{};
+	}
+
+	// Copy ELF (or debug SELF contents) as is
+	elf_or_self.seek(0);
+
+	std::vector<u8> buf(0x100000);
+
+	while (const u64 size = elf_or_self.read(buf.data(), buf.size()))
+	{
+		out.write(buf.data(), size);
+	}
+
+	return out;
+}
+
 bool verify_npdrm_self_headers(const fs::file& self, u8* klic_key, NPD_HEADER* npd_out)
 {
 	if (!self)
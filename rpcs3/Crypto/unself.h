@@ -411,6 +411,7 @@ class SELFDecrypter
 public:
 	SELFDecrypter(const fs::file& s);
 	fs::file MakeElf(bool isElf32);
+	void MakeElf(bool isElf32, fs::file& e);
 	bool LoadHeaders(bool isElf32, SelfAdditionalInfo* out_info = nullptr);
 	void ShowHeaders(bool isElf32);
 	bool LoadMetadata(u8* klic_key);
@@ -448,15 +449,11 @@ private:
 					// Create a pointer to a buffer for decompression.
 					std::unique_ptr<u8[]> decomp_buf(new u8[filesz]);
 
-					// Create a buffer separate from data_buf to uncompress.
-					std::unique_ptr<u8[]> zlib_buf(new u8[data_buf_length]);
-					memcpy(zlib_buf.get(), data_buf.get(), data_buf_length);
-
 					uLongf decomp_buf_length = ::narrow<uLongf>(filesz);
 
-					// Use zlib uncompress on the new buffer.
+					// Use zlib uncompress directly on the segment data (the source is not modified).
 					// decomp_buf_length changes inside the call to uncompress
-					const int rv = uncompress(decomp_buf.get(), &decomp_buf_length, zlib_buf.get() + data_buf_offset, data_buf_length);
+					const int rv = uncompress(decomp_buf.get(), &decomp_buf_length, data_buf.get() + data_buf_offset, data_buf_length - data_buf_offset);
 
 					// Check for errors (TODO: Probably safe to remove this once these changes have passed testing.)
 					switch (rv)
@@ -497,6 +494,9 @@ private:
 };
 
 fs::file decrypt_self(fs::file elf_or_self, u8* klic_key = nullptr, SelfAdditionalInfo* additional_info = nullptr);
+
+// Decrypt SELF segment by segment directly into a new file at the path (ELF is copied as is), returns the opened output file on success
+fs::file decrypt_self_to_file(fs::file elf_or_self, const std::string& path, u8* klic_key = nullptr);
 bool verify_npdrm_self_headers(const fs::file& self, u8* klic_key = nullptr, NPD_HEADER* npd_out = nullptr);
 bool get_npdrm_self_header(const fs::file& self, NPD_HEADER& npd);
 
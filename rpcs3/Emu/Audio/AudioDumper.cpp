@@ -3,8 +3,392 @@
 
 #include "Utilities/date_time.h"
 #include "Emu/System.h"
+#include "Emu/system_config.h"
 
+#include <algorithm>
+#include <array>
 #include <bit>
+#include <cmath>
+
+LOG_CHANNEL(dump_log, "AudioDump");
+
+namespace
+{
+	// MSB-first bit packer for FLAC frames
+	struct flac_bit_writer
+	{
+		std::vector<u8> data;
+		u64 acc = 0;
+		u32 count = 0;
+
+		void put(u32 value, u32 bits)
+		{
+			acc = (acc << bits) | (value & ((u64{1} << bits) - 1));
+			count += bits;
+
+			while (count >= 8)
+			{
+				count -= 8;
+				data.push_back(static_cast<u8>(acc >> count));
+			}
+		}
+
+		void put_unary(u32 zeros)
+		{
+			for (; zeros >= 32; zeros -= 32)
+			{
+				put(0, 32);
+			}
+
+			put(1, zeros + 1);
+		}
+
+		void align()
+		{
+			if (count)
+			{
+				put(0, 8 - count);
+			}
+		}
+	};
+
+	u8 flac_crc8(const u8* data, usz size)
+	{
+		u8 crc = 0;
+
+		for (usz i = 0; i < size; i++)
+		{
+			crc ^= data[i];
+
+			for (u32 b = 0; b < 8; b++)
+			{
+				crc = static_cast<u8>(crc & 0x80 ? (crc << 1) ^ 0x07 : crc << 1);
+			}
+		}
+
+		return crc;
+	}
+
+	u16 flac_crc16(const u8* data, usz size)
+	{
+		static const auto s_table = []()
+		{
+			std::array<u16, 256> table{};
+
+			for (u32 i = 0; i < 256; i++)
+			{
+				u16 crc = static_cast<u16>(i << 8);
+
+				for (u32 b = 0; b < 8; b++)
+				{
+					crc = static_cast<u16>(crc & 0x8000 ? (crc << 1) ^ 0x8005 : crc << 1);
+				}
+
+				table[i] = crc;
+			}
+
+			return table;
+		}();
+
+		u16 crc = 0;
+
+		for (usz i = 0; i < size; i++)
+		{
+			crc = static_cast<u16>((crc << 8) ^ s_table[(crc >> 8) ^ data[i]]);
+		}
+
+		return crc;
+	}
+}
+
+// Minimal FLAC encoder: fixed predictors and Rice coded residuals, 24-bit samples
+struct audio_flac_encoder
+{
+	static constexpr u32 block_size = 4096;
+	static constexpr u32 bits_per_sample = 24;
+
+	const u32 channels;
+	const u32 sample_rate;
+
+	u64 total_samples = 0;
+	u64 frame_number = 0;
+
+	// Interleaved samples not yet encoded (less than one block)
+	std::vector<s32> pending;
+
+	// Temporary buffers
+	std::vector<s32> channel_buf;
+	std::vector<s32> residual;
+	flac_bit_writer bits;
+
+	audio_flac_encoder(u32 channels, u32 sample_rate)
+		: channels(channels)
+		, sample_rate(sample_rate)
+	{
+	}
+
+	void write_header(const fs::file& out) const
+	{
+		flac_bit_writer w;
+		w.put(0x664c6143, 32); // "fLaC"
+
+		// Last metadata block, STREAMINFO, 34 bytes
+		w.put(0x80, 8);
+		w.put(34, 24);
+
+		w.put(block_size, 16);
+		w.put(block_size, 16);
+		w.put(0, 24); // Unknown min frame size
+		w.put(0, 24); // Unknown max frame size
+		w.put(sample_rate, 20);
+		w.put(channels - 1, 3);
+		w.put(bits_per_sample - 1, 5);
+		w.put(static_cast<u32>(total_samples >> 32), 4);
+		w.put(static_cast<u32>(total_samples), 32);
+
+		// No MD5 signature
+		for (u32 i = 0; i < 4; i++)
+		{
+			w.put(0, 32);
+		}
+
+		out.seek(0);
+		out.write(w.data);
+	}
+
+	void encode(const fs::file& out, const f32* samples, usz count)
+	{
+		for (usz i = 0; i < count; i++)
+		{
+			const f32 value = std::clamp(std::nearbyint(samples[i] * 8388607.f), -8388608.f, 8388607.f);
+			pending.push_back(static_cast<s32>(value));
+		}
+
+		const usz block_samples = usz{block_size} * channels;
+		usz pos = 0;
+
+		for (; pending.size() - pos >= block_samples; pos += block_samples)
+		{
+			encode_frame(out, pending.data() + pos, block_size);
+		}
+
+		pending.erase(pending.begin(), pending.begin() + pos);
+	}
+
+	void finish(const fs::file& out)
+	{
+		if (const u32 frames = static_cast<u32>(pending.size() / channels))
+		{
+			encode_frame(out, pending.data(), frames);
+		}
+
+		pending.clear();
+		write_header(out);
+	}
+
+	void encode_frame(const fs::file& out, const s32* samples, u32 frames)
+	{
+		bits.data.clear();
+		bits.acc = 0;
+		bits.count = 0;
+
+		// Frame header: sync code, fixed block size, 16-bit block size at the end, sample rate from STREAMINFO, independent channels, 24 bits per sample
+		bits.put(0xfff8, 16);
+		bits.put(0b0111, 4);
+		bits.put(0b0000, 4);
+		bits.put(channels - 1, 4);
+		bits.put(0b110, 3);
+		bits.put(0, 1);
+		put_utf8(frame_number++);
+		bits.put(frames - 1, 16);
+		bits.put(flac_crc8(bits.data.data(), bits.data.size()), 8);
+
+		channel_buf.resize(frames);
+
+		for (u32 ch = 0; ch < channels; ch++)
+		{
+			for (u32 i = 0; i < frames; i++)
+			{
+				channel_buf[i] = samples[usz{i} * channels + ch];
+			}
+
+			encode_subframe(channel_buf.data(), frames);
+		}
+
+		bits.align();
+
+		const u16 crc = flac_crc16(bits.data.data(), bits.data.size());
+		bits.put(crc, 16);
+
+		out.write(bits.data);
+		total_samples += frames;
+	}
+
+	void put_utf8(u64 value)
+	{
+		if (value < 0x80)
+		{
+			bits.put(static_cast<u32>(value), 8);
+			return;
+		}
+
+		const u32 count = value < 0x800 ? 2 : value < 0x10000 ? 3 : value < 0x200000 ? 4 : value < 0x4000000 ? 5 : value < 0x80000000 ? 6 : 7;
+
+		bits.put(((0xff00u >> count) & 0xff) | static_cast<u32>(value >> (6 * (count - 1))), 8);
+
+		for (u32 i = count - 1; i > 0; i--)
+		{
+			bits.put(0x80 | static_cast<u32>((value >> (6 * (i - 1))) & 0x3f), 8);
+		}
+	}
+
+	void encode_subframe(const s32* s, u32 n)
+	{
+		if (std::all_of(s, s + n, [&](s32 v) { return v == s[0]; }))
+		{
+			// Constant
+			bits.put(0, 8);
+			bits.put(static_cast<u32>(s[0]), bits_per_sample);
+			return;
+		}
+
+		// Select fixed predictor order by the sum of absolute residuals
+		u32 order = 0;
+
+		if (n > 4)
+		{
+			u64 sums[5]{};
+
+			for (u32 i = 4; i < n; i++)
+			{
+				const s64 e0 = s[i];
+				const s64 e1 = e0 - s[i - 1];
+				const s64 e2 = e1 - (s[i - 1] - s[i - 2]);
+				const s64 e3 = e2 - (s[i - 1] - 2 * s64{s[i - 2]} + s[i - 3]);
+				const s64 e4 = e3 - (s[i - 1] - 3 * s64{s[i - 2]} + 3 * s64{s[i - 3]} - s[i - 4]);
+
+				sums[0] += std::abs(e0);
+				sums[1] += std::abs(e1);
+				sums[2] += std::abs(e2);
+				sums[3] += std::abs(e3);
+				sums[4] += std::abs(e4);
+			}
+
+			order = static_cast<u32>(std::min_element(std::begin(sums), std::end(sums)) - std::begin(sums));
+		}
+
+		residual.resize(n);
+
+		for (u32 i = order; i < n; i++)
+		{
+			s64 r = s[i];
+
+			switch (order)
+			{
+			case 1: r -= s[i - 1]; break;
+			case 2: r -= 2 * s64{s[i - 1]} - s[i - 2]; break;
+			case 3: r -= 3 * s64{s[i - 1]} - 3 * s64{s[i - 2]} + s[i - 3]; break;
+			case 4: r -= 4 * s64{s[i - 1]} - 6 * s64{s[i - 2]} + 4 * s64{s[i - 3]} - s[i - 4]; break;
+			default: break;
+			}
+
+			// Zigzag encoding
+			const s32 v = static_cast<s32>(r);
+			residual[i] = static_cast<s32>((static_cast<u32>(v) << 1) ^ static_cast<u32>(v >> 31));
+		}
+
+		// Select partition order and Rice parameters (estimated cost)
+		u32 best_porder = 0;
+		u64 best_cost = umax;
+
+		for (u32 porder = 0; porder <= 8 && n % (1u << porder) == 0 && (n >> porder) > order; porder++)
+		{
+			u64 cost = 0;
+
+			for (u32 p = 0; p < (1u << porder); p++)
+			{
+				const u32 begin = p ? p * (n >> porder) : order;
+				const u32 end = (p + 1) * (n >> porder);
+				cost += 4 + rice_cost(begin, end).second;
+			}
+
+			if (cost < best_cost)
+			{
+				best_cost = cost;
+				best_porder = porder;
+			}
+		}
+
+		if (best_cost + 8 + 6 + u64{order} * bits_per_sample >= u64{n} * bits_per_sample)
+		{
+			// Verbatim
+			bits.put(0b000001 << 1, 8);
+
+			for (u32 i = 0; i < n; i++)
+			{
+				bits.put(static_cast<u32>(s[i]), bits_per_sample);
+			}
+
+			return;
+		}
+
+		// Fixed predictor
+		bits.put((0b001000 | order) << 1, 8);
+
+		for (u32 i = 0; i < order; i++)
+		{
+			bits.put(static_cast<u32>(s[i]), bits_per_sample);
+		}
+
+		bits.put(0, 2); // 4-bit Rice parameters
+		bits.put(best_porder, 4);
+
+		for (u32 p = 0; p < (1u << best_porder); p++)
+		{
+			const u32 begin = p ? p * (n >> best_porder) : order;
+			const u32 end = (p + 1) * (n >> best_porder);
+			const u32 k = rice_cost(begin, end).first;
+
+			bits.put(k, 4);
+
+			for (u32 i = begin; i < end; i++)
+			{
+				const u32 u = static_cast<u32>(residual[i]);
+				bits.put_unary(u >> k);
+				bits.put(u, k);
+			}
+		}
+	}
+
+	// Best Rice parameter and the estimated size in bits of the residual range
+	std::pair<u32, u64> rice_cost(u32 begin, u32 end) const
+	{
+		u64 sum = 0;
+
+		for (u32 i = begin; i < end; i++)
+		{
+			sum += static_cast<u32>(residual[i]);
+		}
+
+		const u64 count = end - begin;
+
+		u32 best_k = 0;
+		u64 best = umax;
+
+		for (u32 k = 0; k < 15; k++)
+		{
+			const u64 cost = count * (k + 1) + (sum >> k);
+
+			if (cost < best)
+			{
+				best = cost;
+				best_k = k;
+			}
+		}
+
+		return {best_k, best};
+	}
+};
 
 AudioDumper::AudioDumper()
 {
@@ -25,15 +409,64 @@ void AudioDumper::Open(AudioChannelCnt ch, AudioFreq sample_rate, AudioSampleSiz
 	{
 		path += id + "_";
 	}
-	path += date_time::current_time_narrow<'_'>() + ".wav";
+
+	// FLAC is only supported for float input
+	if (g_cfg.audio.dump_format == audio_dump_format::flac && sample_size == AudioSampleSize::FLOAT)
+	{
+		m_flac = std::make_unique<audio_flac_encoder>(static_cast<u32>(ch), static_cast<u32>(sample_rate));
+	}
+
+	path += date_time::current_time_narrow<'_'>() + (m_flac ? ".flac" : ".wav");
 	m_output.open(path, fs::rewrite);
-	m_output.seek(sizeof(m_header));
+
+	if (m_flac)
+	{
+		m_flac->write_header(m_output);
+	}
+	else
+	{
+		m_output.seek(sizeof(m_header));
+	}
+
+	dump_log.notice("Dumping audio to %s", path);
+
+	m_thread = std::make_unique<named_thread<std::function<void()>>>("Audio Dumper", [this]()
+	{
+		while (thread_ctrl::state() != thread_state::aborting)
+		{
+			for (auto&& data : m_queue.pop_all())
+			{
+				write_block(data);
+			}
+
+			thread_ctrl::wait_on(m_queue, nullptr);
+		}
+
+		// Write the remaining data
+		for (auto&& data : m_queue.pop_all())
+		{
+			write_block(data);
+		}
+	});
 }
 
 void AudioDumper::Close()
 {
 	if (GetCh())
 	{
+		// Wait for the background writer
+		*m_thread = thread_state::aborting;
+		m_thread.reset();
+
+		if (m_flac)
+		{
+			m_flac->finish(m_output);
+			m_output.close();
+			m_flac.reset();
+			m_header.FMT.NumChannels = 0;
+			return;
+		}
+
 		if (m_header.Size & 1)
 		{
 			const u8 pad_byte = 0;
@@ -57,34 +490,49 @@ void AudioDumper::WriteData(const void* buffer, u32 size)
 
 		ensure(size - sample_cnt_per_ch * blk_size == 0);
 
-		if constexpr (std::endian::big == std::endian::native)
-		{
-			std::vector<u8> tmp_buf(size);
+		// Only copy the data here, the caller may be a real-time audio thread
+		m_queue.push(static_cast<const u8*>(buffer), static_cast<const u8*>(buffer) + size);
+	}
+}
 
-			if (GetSampleSize() == sizeof(f32))
-			{
-				for (u32 sample_idx = 0; sample_idx < sample_cnt_per_ch * GetCh(); sample_idx++)
-				{
-					std::bit_cast<f32*>(tmp_buf.data())[sample_idx] = static_cast<const be_t<f32>*>(buffer)[sample_idx];
-				}
-			}
-			else
+void AudioDumper::write_block(const std::vector<u8>& data)
+{
+	const u32 size = ::size32(data);
+	const u32 sample_cnt_per_ch = size / (GetCh() * GetSampleSize());
+
+	if (m_flac)
+	{
+		m_flac->encode(m_output, reinterpret_cast<const f32*>(data.data()), size / sizeof(f32));
+		return;
+	}
+
+	if constexpr (std::endian::big == std::endian::native)
+	{
+		std::vector<u8> tmp_buf(size);
+
+		if (GetSampleSize() == sizeof(f32))
+		{
+			for (u32 sample_idx = 0; sample_idx < sample_cnt_per_ch * GetCh(); sample_idx++)
 			{
-				for (u32 sample_idx = 0; sample_idx < sample_cnt_per_ch * GetCh(); sample_idx++)
-				{
-					std::bit_cast<s16*>(tmp_buf.data())[sample_idx] = static_cast<const be_t<s16>*>(buffer)[sample_idx];
-				}
+				std::bit_cast<f32*>(tmp_buf.data())[sample_idx] = reinterpret_cast<const be_t<f32>*>(data.data())[sample_idx];
 			}
-
-			ensure(m_output.write(tmp_buf.data(), size) == size);
 		}
 		else
 		{
-			ensure(m_output.write(buffer, size) == size);
+			for (u32 sample_idx = 0; sample_idx < sample_cnt_per_ch * GetCh(); sample_idx++)
+			{
+				std::bit_cast<s16*>(tmp_buf.data())[sample_idx] = reinterpret_cast<const be_t<s16>*>(data.data())[sample_idx];
+			}
 		}
 
-		m_header.Size += size;
-		m_header.RIFF.Size += size;
-		m_header.FACT.SampleLength += sample_cnt_per_ch;
+		ensure(m_output.write(tmp_buf.data(), size) == size);
 	}
+	else
+	{
+		ensure(m_output.write(data.data(), size) == size);
+	}
+
+	m_header.Size += size;
+	m_header.RIFF.Size += size;
+	m_header.FACT.SampleLength += sample_cnt_per_ch;
 }
@@ -2,8 +2,14 @@
 
 #include "util/types.hpp"
 #include "Utilities/File.h"
+#include "Utilities/Thread.h"
+#include "Utilities/lockless.h"
 #include "Emu/Audio/AudioBackend.h"
 
+#include <functional>
+#include <memory>
+#include <vector>
+
 struct WAVHeader
 {
 	struct RIFFHeader
@@ -72,11 +78,22 @@ struct WAVHeader
 	}
 };
 
+struct audio_flac_encoder;
+
 class AudioDumper
 {
 	WAVHeader m_header{};
 	fs::file m_output{};
 
+	// Set if dumping to FLAC (24-bit) instead of WAV
+	std::unique_ptr<audio_flac_encoder> m_flac;
+
+	// Data is converted and written by the background thread
+	lf_queue<std::vector<u8>> m_queue;
+	std::unique_ptr<named_thread<std::function<void()>>> m_thread;
+
+	void write_block(const std::vector<u8>& data);
+
 public:
 	AudioDumper();
 	~AudioDumper();
@@ -1,11 +1,36 @@
 #include "stdafx.h"
 #include "Emu/Audio/audio_resampler.h"
 #include <algorithm>
+#include <array>
+
+// Catmull-Rom cubic interpolation weights for frames (-1, 0, 1, 2), for 256 fractional positions (+ the end point)
+static constexpr u32 s_phase_count = 256;
+
+static const auto s_cubic_weights = []()
+{
+	std::array<std::array<f32, 4>, s_phase_count + 1> result{};
+
+	for (u32 i = 0; i <= s_phase_count; i++)
+	{
+		const f64 t = static_cast<f64>(i) / s_phase_count;
+		const f64 t2 = t * t;
+		const f64 t3 = t2 * t;
+
+		result[i][0] = static_cast<f32>((-t3 + 2 * t2 - t) / 2);
+		result[i][1] = static_cast<f32>((3 * t3 - 5 * t2 + 2) / 2);
+		result[i][2] = static_cast<f32>((-3 * t3 + 4 * t2 + t) / 2);
+		result[i][3] = static_cast<f32>((t3 - t2) / 2);
+	}
+
+	return result;
+}();
 
 audio_resampler::audio_resampler()
 {
 	resampler.setSetting(SETTING_SEQUENCE_MS, 20); // Resampler frame size (reduce latency at cost of slight sound quality degradation)
 	resampler.setSetting(SETTING_USE_QUICKSEEK, 1); // Use fast quick seeking algorithm (substantally reduces computation time)
+
+	flush();
 }
 
 audio_resampler::~audio_resampler()
@@ -14,6 +39,7 @@ audio_resampler::~audio_resampler()
 
 void audio_resampler::set_params(AudioChannelCnt ch_cnt, AudioFreq freq)
 {
+	m_channels = static_cast<u32>(ch_cnt);
 	flush();
 	resampler.setChannels(static_cast<u32>(ch_cnt));
 	resampler.setSampleRate(static_cast<u32>(freq));
@@ -22,32 +48,156 @@ void audio_resampler::set_params(AudioChannelCnt ch_cnt, AudioFreq freq)
 f64 audio_resampler::set_tempo(f64 new_tempo)
 {
 	new_tempo = std::clamp(new_tempo, RESAMPLER_MIN_FREQ_VAL, RESAMPLER_MAX_FREQ_VAL);
-	resampler.setTempo(new_tempo);
+
+	// Only fall back to time stretching when running far below full speed (with hysteresis, so that a tempo around the threshold doesn't keep switching)
+	if (m_time_stretch ? new_tempo >= RESAMPLER_STRETCH_EXIT_FREQ_VAL : new_tempo < RESAMPLER_STRETCH_FREQ_VAL)
+	{
+		set_time_stretch(!m_time_stretch);
+	}
+
+	m_tempo = new_tempo;
+
+	if (m_time_stretch)
+	{
+		resampler.setTempo(new_tempo);
+	}
+
 	return new_tempo;
 }
 
+void audio_resampler::set_time_stretch(bool enable)
+{
+	if (m_time_stretch == enable)
+	{
+		return;
+	}
+
+	m_time_stretch = enable;
+
+	if (enable)
+	{
+		// Move the unconsumed input to SoundTouch
+		const usz first = std::min<usz>(static_cast<usz>(m_pos), m_input.size() / m_channels);
+		const usz frames = m_input.size() / m_channels - first;
+
+		if (frames)
+		{
+			resampler.putSamples(m_input.data() + first * m_channels, static_cast<u32>(frames));
+		}
+
+		m_input.assign(m_channels, 0.0f);
+		m_pos = 1.0;
+		return;
+	}
+
+	// Process the input still held in SoundTouch's window, then keep all of its output
+	resampler.flush();
+
+	const u32 frames = resampler.numSamples();
+	m_input.resize(m_channels + usz{frames} * m_channels);
+
+	if (frames)
+	{
+		resampler.receiveSamples(m_input.data() + m_channels, frames);
+	}
+
+	resampler.clear();
+}
+
 void audio_resampler::put_samples(const f32* buf, u32 sample_cnt)
 {
-	resampler.putSamples(buf, sample_cnt);
+	if (m_time_stretch)
+	{
+		resampler.putSamples(buf, sample_cnt);
+		return;
+	}
+
+	m_input.insert(m_input.end(), buf, buf + usz{sample_cnt} * m_channels);
 }
 
 std::pair<f32* /* buffer */, u32 /* samples */> audio_resampler::get_samples(u32 sample_cnt)
 {
-	f32 *const buf = resampler.bufBegin();
-	return std::make_pair(buf, resampler.receiveSamples(sample_cnt));
+	if (m_time_stretch)
+	{
+		f32 *const buf = resampler.bufBegin();
+		return std::make_pair(buf, resampler.receiveSamples(sample_cnt));
+	}
+
+	const u32 ch = m_channels;
+	const usz frames = m_input.size() / ch;
+
+	if (m_output.size() < usz{sample_cnt} * ch)
+	{
+		m_output.resize(usz{sample_cnt} * ch);
+	}
+
+	u32 produced = 0;
+
+	for (; produced < sample_cnt; produced++)
+	{
+		const usz i = static_cast<usz>(m_pos);
+
+		// Needs frames i - 1 .. i + 2
+		if (i + 2 >= frames)
+		{
+			break;
+		}
+
+		const auto& w = s_cubic_weights[static_cast<usz>((m_pos - i) * s_phase_count + 0.5)];
+		const f32* src = m_input.data() + (i - 1) * ch;
+		f32* dst = m_output.data() + usz{produced} * ch;
+
+		for (u32 c = 0; c < ch; c++)
+		{
+			dst[c] = w[0] * src[c] + w[1] * src[c + ch] + w[2] * src[c + ch * 2] + w[3] * src[c + ch * 3];
+		}
+
+		m_pos += m_tempo;
+	}
+
+	// Drop consumed input, keep one frame of history
+	const usz consumed = std::min<usz>(static_cast<usz>(m_pos), frames) - 1;
+
+	if (consumed)
+	{
+		m_input.erase(m_input.begin(), m_input.begin() + consumed * ch);
+		m_pos -= static_cast<f64>(consumed);
+	}
+
+	return std::make_pair(m_output.data(), produced);
 }
 
 u32 audio_resampler::samples_available() const
 {
-	return resampler.numSamples();
+	if (m_time_stretch)
+	{
+		return resampler.numSamples();
+	}
+
+	const f64 frames = static_cast<f64>(m_input.size() / m_channels);
+
+	if (m_pos + 2 >= frames)
+	{
+		return 0;
+	}
+
+	return static_cast<u32>((frames - 2 - m_pos) / m_tempo) + 1;
 }
 
 f64 audio_resampler::get_resample_ratio()
 {
-	return resampler.getInputOutputSampleRatio();
+	if (m_time_stretch)
+	{
+		return resampler.getInputOutputSampleRatio();
+	}
+
+	return m_tempo;
 }
 
 void audio_resampler::flush()
 {
 	resampler.clear();
+
+	m_input.assign(m_channels, 0.0f);
+	m_pos = 1.0;
 }
@@ -2,6 +2,7 @@
 
 #include "util/types.hpp"
 #include "Emu/Audio/AudioBackend.h"
+#include <vector>
 
 #ifndef _MSC_VER
 #pragma GCC diagnostic push
@@ -15,6 +16,12 @@
 constexpr f64 RESAMPLER_MAX_FREQ_VAL = 1.0;
 constexpr f64 RESAMPLER_MIN_FREQ_VAL = 0.1;
 
+// Tempo values above this are handled by plain resampling (slight pitch shift, minimal latency), below by SoundTouch time stretching
+constexpr f64 RESAMPLER_STRETCH_FREQ_VAL = 0.97;
+
+// Tempo values at or above this switch back from time stretching to resampling
+constexpr f64 RESAMPLER_STRETCH_EXIT_FREQ_VAL = 0.99;
+
 class audio_resampler
 {
 public:
@@ -33,5 +40,18 @@ public:
 	void flush();
 
 private:
+	// Switch between resampling and time stretching, moving the pending samples
+	void set_time_stretch(bool enable);
+
 	soundtouch::SoundTouch resampler{};
+
+	bool m_time_stretch = false;
+	u32 m_channels = 2;
+	f64 m_tempo = RESAMPLER_MAX_FREQ_VAL;
+
+	// Resampler input (interleaved frames, the first one is history) and fractional read position
+	std::vector<f32> m_input{};
+	f64 m_pos = 1.0;
+
+	std::vector<f32> m_output{};
 };
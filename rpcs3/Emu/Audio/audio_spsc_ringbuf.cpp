@@ -0,0 +1,141 @@
+#include "stdafx.h"
+#include "audio_spsc_ringbuf.h"
+
+void audio_spsc_ringbuf::set_buf_size(u64 size, u64 bytes_per_sec)
+{
+	ensure(size && size != umax);
+
+	m_buf.resize(size);
+	m_bytes_per_ms = std::max<u64>(bytes_per_sec / 1000, 1);
+
+	m_read_pos.release(0);
+	m_write_pos.release(0);
+	m_underruns.release(0);
+	m_overruns.release(0);
+
+	for (auto& bucket : m_latency)
+	{
+		bucket.release(0);
+	}
+}
+
+u64 audio_spsc_ringbuf::get_free_size() const
+{
+	return m_buf.size() - get_used_size();
+}
+
+u64 audio_spsc_ringbuf::get_used_size() const
+{
+	// Read position first: it can only grow up to the write position
+	const u64 rd = m_read_pos.load();
+	const u64 wr = m_write_pos.load();
+	return std::min<u64>(wr - rd, m_buf.size());
+}
+
+u64 audio_spsc_ringbuf::get_total_size() const
+{
+	return m_buf.size();
+}
+
+u64 audio_spsc_ringbuf::push(const void* data, u64 size, bool force)
+{
+	ensure(data != nullptr);
+
+	const u64 buf_size  = m_buf.size();
+	const u64 wr        = m_write_pos.observe();
+	const u64 free_size = buf_size - (wr - m_read_pos.load());
+	const u64 to_push   = std::min(size, free_size);
+	const auto b_data   = static_cast<const u8*>(data);
+
+	if (to_push < size)
+	{
+		m_overruns.release(m_overruns.observe() + 1);
+	}
+
+	if (!to_push || (!force && to_push < size))
+	{
+		return 0;
+	}
+
+	const u64 old = wr % buf_size;
+
+	if (old + to_push > buf_size)
+	{
+		const auto first_write_sz = buf_size - old;
+		std::memcpy(&m_buf[old], b_data, first_write_sz);
+		std::memcpy(&m_buf[0], b_data + first_write_sz, to_push - first_write_sz);
+	}
+	else
+	{
+		std::memcpy(&m_buf[old], b_data, to_push);
+	}
+
+	m_write_pos.release(wr + to_push);
+	return to_push;
+}
+
+void audio_spsc_ringbuf::writer_flush()
+{
+	m_write_pos.release(m_read_pos.load());
+}
+
+u64 audio_spsc_ringbuf::pop(void* data, u64 size, bool force)
+{
+	ensure(data != nullptr);
+
+	const u64 buf_size  = m_buf.size();
+	const u64 rd        = m_read_pos.observe();
+	const u64 used_size = m_write_pos.load() - rd;
+	const u64 to_pop    = std::min(size, used_size);
+	const auto b_data   = static_cast<u8*>(data);
+
+	// Playtime buffered at the moment of the request
+	const u64 latency_ms = used_size / m_bytes_per_ms;
+	auto& bucket = m_latency[std::min<u32>(64 - std::countl_zero(latency_ms), latency_bucket_count - 1)];
+	bucket.release(bucket.observe() + 1);
+
+	if (to_pop < size)
+	{
+		m_underruns.release(m_underruns.observe() + 1);
+	}
+
+	if (!to_pop || (!force && to_pop < size))
+	{
+		return 0;
+	}
+
+	const u64 old = rd % buf_size;
+
+	if (old + to_pop > buf_size)
+	{
+		const auto first_read_sz = buf_size - old;
+		std::memcpy(b_data, &m_buf[old], first_read_sz);
+		std::memcpy(b_data + first_read_sz, &m_buf[0], to_pop - first_read_sz);
+	}
+	else
+	{
+		std::memcpy(b_data, &m_buf[old], to_pop);
+	}
+
+	m_read_pos.release(rd + to_pop);
+	return to_pop;
+}
+
+void audio_spsc_ringbuf::reader_flush()
+{
+	m_read_pos.release(m_write_pos.load());
+}
+
+audio_spsc_ringbuf::stats_t audio_spsc_ringbuf::get_stats() const
+{
+	stats_t result{};
+	result.underruns = m_underruns.load();
+	result.overruns = m_overruns.load();
+
+	for (u32 i = 0; i < latency_bucket_count; i++)
+	{
+		result.latency[i] = m_latency[i].load();
+	}
+
+	return result;
+}
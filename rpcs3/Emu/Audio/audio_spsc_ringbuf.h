@@ -0,0 +1,64 @@
+#pragma once
+
+#include "util/types.hpp"
+#include "util/atomic.hpp"
+#include <array>
+#include <vector>
+
+// Wait-free single producer/single consumer byte ring between the audio mixer and the backend write callback.
+// Also counts underruns/overruns and builds a histogram of the buffered playtime seen by the consumer.
+class audio_spsc_ringbuf
+{
+public:
+	// < 1ms, < 2ms, < 4ms, ..., < 256ms, >= 256ms
+	static constexpr u32 latency_bucket_count = 10;
+
+	struct stats_t
+	{
+		u64 underruns = 0;
+		u64 overruns = 0;
+		std::array<u64, latency_bucket_count> latency{};
+	};
+
+	audio_spsc_ringbuf() = default;
+
+	audio_spsc_ringbuf(const audio_spsc_ringbuf&) = delete;
+
+	audio_spsc_ringbuf& operator=(const audio_spsc_ringbuf&) = delete;
+
+	// Thread unsafe: allocate the buffer and reset stats (bytes_per_sec is used to compute the buffered playtime)
+	void set_buf_size(u64 size, u64 bytes_per_sec);
+
+	u64 get_free_size() const;
+	u64 get_used_size() const;
+	u64 get_total_size() const;
+
+	// Producer: returns the number of bytes pushed (nothing unless everything fits or force is set)
+	u64 push(const void* data, u64 size, bool force = false);
+
+	// Producer: drop all enqueued data (the consumer must not be active)
+	void writer_flush();
+
+	// Consumer: returns the number of bytes popped (nothing unless enough data is available or force is set)
+	u64 pop(void* data, u64 size, bool force = false);
+
+	// Consumer: drop all enqueued data
+	void reader_flush();
+
+	stats_t get_stats() const;
+
+private:
+	// Both positions only grow, the difference is the number of enqueued bytes
+	alignas(64) atomic_t<u64> m_read_pos{0};
+	alignas(64) atomic_t<u64> m_write_pos{0};
+
+	// Written only by the consumer
+	alignas(64) atomic_t<u64> m_underruns{0};
+	std::array<atomic_t<u64>, latency_bucket_count> m_latency{};
+
+	// Written only by the producer
+	alignas(64) atomic_t<u64> m_overruns{0};
+
+	std::vector<u8> m_buf{};
+	u64 m_bytes_per_ms = 1;
+};
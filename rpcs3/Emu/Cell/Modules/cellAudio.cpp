@@ -1,10 +1,13 @@
 #include "stdafx.h"
 #include "Emu/System.h"
+#include "Emu/perf_meter.hpp"
 #include "Emu/Cell/PPUModule.h"
 
 #include "Emu/Cell/lv2/sys_process.h"
 #include "Emu/Cell/lv2/sys_event.h"
 #include "cellAudio.h"
+#include "util/v128.hpp"
+#include "util/simd.hpp"
 
 #include <cmath>
 
@@ -142,7 +145,8 @@ audio_ringbuffer::audio_ringbuffer(cell_audio_config& _cfg)
 		return cfg.audio_min_buffer_duration;
 	}();
 
-	cb_ringbuf.set_buf_size(static_cast<u32>(cfg.audio_channels * cfg.audio_sampling_rate * cfg.audio_sample_size * buffer_dur_mult));
+	const u32 bytes_per_sec = cfg.audio_channels * cfg.audio_sampling_rate * cfg.audio_sample_size;
+	cb_ringbuf.set_buf_size(static_cast<u32>(bytes_per_sec * buffer_dur_mult), bytes_per_sec);
 	backend->SetWriteCallback(std::bind(&audio_ringbuffer::backend_write_callback, this, std::placeholders::_1, std::placeholders::_2));
 }
 
@@ -154,6 +158,28 @@ audio_ringbuffer::~audio_ringbuffer()
 	}
 
 	backend->Close();
+
+	const auto stats = cb_ringbuf.get_stats();
+
+	if (stats.underruns || stats.overruns)
+	{
+		perf_log.notice("Audio ringbuffer (%s): underruns: %u, overruns: %u", backend->GetName(), stats.underruns, stats.overruns);
+	}
+
+	for (u32 i = 0; i < stats.latency.size(); i++)
+	{
+		if (const u64 count = stats.latency[i])
+		{
+			if (i + 1 < stats.latency.size())
+			{
+				perf_log.notice("Audio ringbuffer (%s): buffered < %ums: %u", backend->GetName(), 1u << i, count);
+			}
+			else
+			{
+				perf_log.notice("Audio ringbuffer (%s): buffered >= %ums: %u", backend->GetName(), 1u << (i - 1), count);
+			}
+		}
+	}
 }
 
 f32 audio_ringbuffer::set_frequency_ratio(f32 new_ratio)
@@ -746,6 +772,11 @@ void cell_audio_thread::operator()()
 						ringbuffer->set_frequency_ratio(req_time_stretching_step);
 					}
 				}
+				else if (desired_duration_rate < 1.0f)
+				{
+					// Slightly below the desired duration: continuously hold the buffer level with small resampling ratio changes
+					ringbuffer->set_frequency_ratio(std::max(1.0f - (1.0f - desired_duration_rate) * cfg.resampling_gain, static_cast<f32>(RESAMPLER_STRETCH_FREQ_VAL)));
+				}
 				else if (frequency_ratio != RESAMPLER_MAX_FREQ_VAL)
 				{
 					ringbuffer->set_frequency_ratio(RESAMPLER_MAX_FREQ_VAL);
@@ -842,6 +873,8 @@ void cell_audio_thread::operator()()
 			}
 		}
 
+		perf_meter<"AUDMIX"_u64> perf0;
+
 		// Mix
 		float *buf = ringbuffer->get_current_buffer();
 
@@ -884,6 +917,22 @@ audio_port* cell_audio_thread::open_port()
 	return nullptr;
 }
 
+// Load 4 big-endian floats
+static inline v128 load_be_f32x4(const be_t<f32>* ptr)
+{
+	const v128 x = v128::loadu(ptr);
+
+	// Swap bytes in each 16-bit half, then swap the halves
+	const v128 y = gv_or32(gv_shl16(x, 8), gv_shr16(x, 8));
+	return gv_or32(gv_shl32(y, 16), gv_shr32(y, 16));
+}
+
+// Swap 64-bit halves: {0, 1, 2, 3} -> {2, 3, 0, 1}
+static inline v128 swap_halves(const v128& x)
+{
+	return gv_or32(gv_shuffle_left<8>(x), gv_shuffle_right<8>(x));
+}
+
 template <AudioChannelCnt downmix>
 void cell_audio_thread::mix(float *out_buffer, s32 offset)
 {
@@ -892,26 +941,29 @@ void cell_audio_thread::mix(float *out_buffer, s32 offset)
 	constexpr u32 channels = static_cast<u32>(downmix);
 	constexpr u32 out_buffer_sz = channels * AUDIO_BUFFER_SAMPLES;
 
-	bool first_mix = true;
+	// All ports are accumulated into the cleared buffer
+	std::memset(out_buffer, 0, out_buffer_sz * sizeof(float));
 
 	const float master_volume = g_cfg.audio.volume / 100.0f;
 
+	// Volume of each sample frame
+	alignas(16) float volume[AUDIO_BUFFER_SAMPLES];
+
 	// mixing
 	for (auto& port : ports)
 	{
 		if (port.state != audio_port_state::started) continue;
 
-		auto buf = port.get_vm_ptr(offset);
+		const be_t<f32>* buf = port.get_vm_ptr(offset);
 
 		static constexpr float minus_3db = 0.707f; // value taken from https://www.dolby.com/us/en/technologies/a-guide-to-dolby-metadata.pdf
-		float m = master_volume;
 
 		// part of cellAudioSetPortLevel functionality
 		// spread port volume changes over 13ms
-		auto step_volume = [master_volume, &m](audio_port& port)
-		{
-			const auto param = port.level_set.load();
+		auto param = port.level_set.load();
 
+		for (u32 i = 0; i < AUDIO_BUFFER_SAMPLES; i++)
+		{
 			if (param.inc != 0.0f)
 			{
 				port.level += param.inc;
@@ -921,146 +973,70 @@ void cell_audio_thread::mix(float *out_buffer, s32 offset)
 				{
 					port.level = param.value;
 					port.level_set.compare_and_swap(param, { param.value, 0.0f });
+					param = port.level_set.load();
 				}
 			}
 
-			m = port.level * master_volume;
-		};
+			volume[i] = port.level * master_volume;
+		}
 
 		if (port.num_channels == 2)
 		{
-			if (first_mix)
+			// Two frames per vector
+			for (u32 out = 0, in = 0, i = 0; i < AUDIO_BUFFER_SAMPLES; out += channels * 2, in += 4, i += 2)
 			{
-				for (u32 out = 0, in = 0; out < out_buffer_sz; out += channels, in += 2)
-				{
-					step_volume(port);
-
-					const float left  = buf[in + 0] * m;
-					const float right = buf[in + 1] * m;
-
-					out_buffer[out + 0] = left;
-					out_buffer[out + 1] = right;
+				const v128 m = v128::from32(std::bit_cast<u32>(volume[i]), std::bit_cast<u32>(volume[i]), std::bit_cast<u32>(volume[i + 1]), std::bit_cast<u32>(volume[i + 1]));
+				const v128 samples = gv_mulfs(load_be_f32x4(buf + in), m);
 
-					if constexpr (downmix != AudioChannelCnt::STEREO)
-					{
-						out_buffer[out + 2] = 0.0f;
-						out_buffer[out + 3] = 0.0f;
-						out_buffer[out + 4] = 0.0f;
-						out_buffer[out + 5] = 0.0f;
-
-						if constexpr (downmix != AudioChannelCnt::SURROUND_5_1)
-						{
-							out_buffer[out + 6] = 0.0f;
-							out_buffer[out + 7] = 0.0f;
-						}
-					}
+				if constexpr (downmix == AudioChannelCnt::STEREO)
+				{
+					v128::storeu(gv_addfs(v128::loadu(out_buffer + out), samples), out_buffer + out);
 				}
-				first_mix = false;
-			}
-			else
-			{
-				for (u32 out = 0, in = 0; out < out_buffer_sz; out += channels, in += 2)
+				else
 				{
-					step_volume(port);
-
-					const float left  = buf[in + 0] * m;
-					const float right = buf[in + 1] * m;
-
-					out_buffer[out + 0] += left;
-					out_buffer[out + 1] += right;
+					out_buffer[out + 0] += samples._f[0];
+					out_buffer[out + 1] += samples._f[1];
+					out_buffer[out + channels + 0] += samples._f[2];
+					out_buffer[out + channels + 1] += samples._f[3];
 				}
 			}
 		}
 		else if (port.num_channels == 8)
 		{
-			if (first_mix)
+			for (u32 out = 0, in = 0, i = 0; i < AUDIO_BUFFER_SAMPLES; out += channels, in += 8, i++)
 			{
-				for (u32 out = 0, in = 0; out < out_buffer_sz; out += channels, in += 8)
+				const v128 m = gv_bcstfs(volume[i]);
+
+				// left, right, center, low_freq
+				const v128 front = gv_mulfs(load_be_f32x4(buf + in), m);
+
+				// side_left, side_right, rear_left, rear_right
+				const v128 back = gv_mulfs(load_be_f32x4(buf + in + 4), m);
+
+				if constexpr (downmix == AudioChannelCnt::STEREO)
 				{
-					step_volume(port);
-
-					const float left       = buf[in + 0] * m;
-					const float right      = buf[in + 1] * m;
-					const float center     = buf[in + 2] * m;
-					[[maybe_unused]]
-					const float low_freq   = buf[in + 3] * m;
-					const float side_left  = buf[in + 4] * m;
-					const float side_right = buf[in + 5] * m;
-					const float rear_left  = buf[in + 6] * m;
-					const float rear_right = buf[in + 7] * m;
-
-					if constexpr (downmix == AudioChannelCnt::STEREO)
-					{
-						// Don't mix in the lfe as per dolby specification and based on documentation
-						const float mid = center * 0.5f;
-						out_buffer[out + 0] = left * minus_3db + mid + side_left * 0.5f + rear_left * 0.5f;
-						out_buffer[out + 1] = right * minus_3db + mid + side_right * 0.5f + rear_right * 0.5f;
-					}
-					else if constexpr (downmix == AudioChannelCnt::SURROUND_5_1)
-					{
-						out_buffer[out + 0] = left;
-						out_buffer[out + 1] = right;
-						out_buffer[out + 2] = center;
-						out_buffer[out + 3] = low_freq;
-						out_buffer[out + 4] = side_left + rear_left;
-						out_buffer[out + 5] = side_right + rear_right;
-					}
-					else
-					{
-						out_buffer[out + 0] = left;
-						out_buffer[out + 1] = right;
-						out_buffer[out + 2] = center;
-						out_buffer[out + 3] = low_freq;
-						out_buffer[out + 4] = rear_left;
-						out_buffer[out + 5] = rear_right;
-						out_buffer[out + 6] = side_left;
-						out_buffer[out + 7] = side_right;
-					}
+					// Don't mix in the lfe as per dolby specification and based on documentation
+					const v128 half_back = gv_mulfs(back, gv_bcstfs(0.5f));
+					const v128 sides = gv_addfs(half_back, swap_halves(half_back));
+					const v128 front_lr = gv_mulfs(front, v128::from32(std::bit_cast<u32>(minus_3db), std::bit_cast<u32>(minus_3db)));
+					const v128 mixed = gv_addfs(gv_addfs(front_lr, sides), gv_bcstfs(front._f[2] * 0.5f));
+
+					out_buffer[out + 0] += mixed._f[0];
+					out_buffer[out + 1] += mixed._f[1];
 				}
-				first_mix = false;
-			}
-			else
-			{
-				for (u32 out = 0, in = 0; out < out_buffer_sz; out += channels, in += 8)
+				else if constexpr (downmix == AudioChannelCnt::SURROUND_5_1)
 				{
-					step_volume(port);
-
-					const float left       = buf[in + 0] * m;
-					const float right      = buf[in + 1] * m;
-					const float center     = buf[in + 2] * m;
-					const float low_freq   = buf[in + 3] * m;
-					const float side_left  = buf[in + 4] * m;
-					const float side_right = buf[in + 5] * m;
-					const float rear_left  = buf[in + 6] * m;
-					const float rear_right = buf[in + 7] * m;
-
-					if constexpr (downmix == AudioChannelCnt::STEREO)
-					{
-						// Don't mix in the lfe as per dolby specification and based on documentation
-						const float mid = center * 0.5f;
-						out_buffer[out + 0] += left * minus_3db + mid + side_left * 0.5f + rear_left * 0.5f;
-						out_buffer[out + 1] += right * minus_3db + mid + side_right * 0.5f + rear_right * 0.5f;
-					}
-					else if constexpr (downmix == AudioChannelCnt::SURROUND_5_1)
-					{
-						out_buffer[out + 0] += left;
-						out_buffer[out + 1] += right;
-						out_buffer[out + 2] += center;
-						out_buffer[out + 3] += low_freq;
-						out_buffer[out + 4] += side_left + rear_left;
-						out_buffer[out + 5] += side_right + rear_right;
-					}
-					else
-					{
-						out_buffer[out + 0] += left;
-						out_buffer[out + 1] += right;
-						out_buffer[out + 2] += center;
-						out_buffer[out + 3] += low_freq;
-						out_buffer[out + 4] += rear_left;
-						out_buffer[out + 5] += rear_right;
-						out_buffer[out + 6] += side_left;
-						out_buffer[out + 7] += side_right;
-					}
+					const v128 sides = gv_addfs(back, swap_halves(back));
+
+					v128::storeu(gv_addfs(v128::loadu(out_buffer + out), front), out_buffer + out);
+					out_buffer[out + 4] += sides._f[0];
+					out_buffer[out + 5] += sides._f[1];
+				}
+				else
+				{
+					// rear_left, rear_right, side_left, side_right
+					v128::storeu(gv_addfs(v128::loadu(out_buffer + out), front), out_buffer + out);
+					v128::storeu(gv_addfs(v128::loadu(out_buffer + out + 4), swap_halves(back)), out_buffer + out + 4);
 				}
 			}
 		}
@@ -1069,12 +1045,6 @@ void cell_audio_thread::mix(float *out_buffer, s32 offset)
 			fmt::throw_exception("Unknown channel count (port=%u, channel=%d)", port.number, port.num_channels);
 		}
 	}
-
-	// Nothing was mixed, memset out_buffer to 0
-	if (first_mix)
-	{
-		std::memset(out_buffer, 0, out_buffer_sz * sizeof(float));
-	}
 }
 
 void cell_audio_thread::finish_port_volume_stepping()
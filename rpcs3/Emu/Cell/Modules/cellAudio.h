@@ -2,7 +2,7 @@
 
 #include "Emu/Memory/vm_ptr.h"
 #include "Utilities/Thread.h"
-#include "Utilities/simple_ringbuf.h"
+#include "Emu/Audio/audio_spsc_ringbuf.h"
 #include "Emu/Memory/vm.h"
 #include "Emu/Audio/AudioBackend.h"
 #include "Emu/Audio/AudioDumper.h"
@@ -251,6 +251,7 @@ struct cell_audio_config
 
 	f32 time_stretching_threshold = 0.0f; // we only apply time stretching below this buffer fill rate (adjusted for average period)
 	static constexpr f32 time_stretching_step = 0.1f; // will only reduce/increase the frequency ratio in steps of at least this value
+	static constexpr f32 resampling_gain = 0.04f; // frequency ratio change per buffer fill rate deficit above time_stretching_threshold (resampling only)
 
 	/*
 	 * Constructor
@@ -276,7 +277,7 @@ private:
 
 	std::unique_ptr<float[]> buffer[MAX_AUDIO_BUFFERS]{};
 
-	simple_ringbuf cb_ringbuf{};
+	audio_spsc_ringbuf cb_ringbuf{};
 	audio_resampler resampler{};
 
 	atomic_t<bool> backend_active = false;
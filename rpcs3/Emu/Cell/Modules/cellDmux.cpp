@@ -8,6 +8,8 @@
 #include "cellDmux.h"
 
 #include "util/asm.hpp"
+#include "util/v128.hpp"
+#include "util/simd.hpp"
 
 LOG_CHANNEL(cellDmux);
 
@@ -45,6 +47,36 @@ enum
 	PRIVATE_STREAM_2         = 0x000001bf,
 };
 
+// Find the next 00 00 01 start code prefix (returns size if not found)
+static u32 find_start_code(const u8* data, u32 size)
+{
+	u32 i = 0;
+
+	const v128 zero{};
+	const v128 one = v128::from8p(1);
+
+	// Test 16 positions at once
+	for (; i + 18 <= size; i += 16)
+	{
+		const v128 m = gv_eq8(v128::loadu(data + i), zero) & gv_eq8(v128::loadu(data + i + 1), zero) & gv_eq8(v128::loadu(data + i + 2), one);
+
+		if (!gv_testz(m))
+		{
+			break;
+		}
+	}
+
+	for (; i + 3 <= size; i++)
+	{
+		if (data[i] == 0 && data[i + 1] == 0 && data[i + 2] == 1)
+		{
+			return i;
+		}
+	}
+
+	return size;
+}
+
 struct DemuxerStream
 {
 	u32 addr;
@@ -181,12 +213,17 @@ public:
 	const u32 spec; //addr
 
 	std::vector<u8> raw_data; // demultiplexed data stream (managed by demuxer thread)
-	usz raw_pos = 0; // should be <= raw_data.size()
+	usz raw_pos = 0; // should be <= raw_data.size(), data before it has already been pushed as AU
 	u64 last_dts = CODEC_TS_INVALID;
 	u64 last_pts = CODEC_TS_INVALID;
 
 	void push(DemuxerStream& stream, u32 size); // called by demuxer thread (not multithread-safe)
 
+	u32 raw_size() const
+	{
+		return ::size32(raw_data) - static_cast<u32>(raw_pos);
+	}
+
 	bool isfull(u32 space);
 
 	void push_au(u32 size, u64 dts, u64 pts, u64 userdata, bool rap, u32 specific);
@@ -363,7 +400,7 @@ public:
 					if ((fid_minor & -0x10) == 0 && esATX[ch])
 					{
 						ElementaryStream& es = *esATX[ch];
-						if (es.raw_data.size() > 1024 * 1024)
+						if (es.raw_size() > 1024 * 1024)
 						{
 							stream = backup;
 							std::this_thread::sleep_for(1ms); // hack
@@ -459,7 +496,7 @@ public:
 					{
 						ElementaryStream& es = *esAVC[ch];
 
-						const u32 old_size = ::size32(es.raw_data);
+						const u32 old_size = es.raw_size();
 						if (es.isfull(old_size))
 						{
 							stream = backup;
@@ -507,8 +544,8 @@ public:
 						fmt::throw_exception("Unknown code found (0x%x)", code);
 					}
 
-					// search
-					stream.skip(1);
+					// search for the next start code
+					stream.skip(find_start_code(static_cast<const u8*>(vm::base(stream.addr + 1)), stream.size - 1) + 1);
 				}
 				}
 
@@ -625,7 +662,7 @@ public:
 			{
 				ElementaryStream& es = *task.es.es_ptr;
 
-				const u32 old_size = ::size32(es.raw_data);
+				const u32 old_size = es.raw_size();
 				if (old_size && (es.fidMajor & -0x10) == 0xe0)
 				{
 					// TODO (it's only for AVC, some ATX data may be lost)
@@ -646,9 +683,9 @@ public:
 					lv2_obj::sleep(*this);
 				}
 
-				if (!es.raw_data.empty())
+				if (es.raw_size())
 				{
-					cellDmux.error("dmuxFlushEs: 0x%x bytes lost (es_id=%d)", ::size32(es.raw_data), es.id);
+					cellDmux.error("dmuxFlushEs: 0x%x bytes lost (es_id=%d)", es.raw_size(), es.id);
 				}
 
 				// callback
@@ -818,8 +855,9 @@ void ElementaryStream::push_au(u32 size, u64 dts, u64 pts, u64 userdata, bool ra
 			put = memAddr;
 		}
 
-		std::memcpy(vm::base(put + 128), raw_data.data(), size);
-		raw_data.erase(raw_data.begin(), raw_data.begin() + size);
+		// Consume the data without moving the rest of the buffer (compacted in push)
+		std::memcpy(vm::base(put + 128), raw_data.data() + raw_pos, size);
+		raw_pos += size;
 
 		auto info = vm::ptr<CellDmuxAuInfoEx>::make(put);
 		info->auAddr = put + 128;
@@ -857,6 +895,13 @@ void ElementaryStream::push_au(u32 size, u64 dts, u64 pts, u64 userdata, bool ra
 
 void ElementaryStream::push(DemuxerStream& stream, u32 size)
 {
+	if (raw_pos && raw_pos >= raw_data.size() / 2)
+	{
+		// Drop the consumed data
+		raw_data.erase(raw_data.begin(), raw_data.begin() + raw_pos);
+		raw_pos = 0;
+	}
+
 	auto const old_size = raw_data.size();
 
 	raw_data.resize(old_size + size);
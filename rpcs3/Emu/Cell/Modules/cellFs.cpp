@@ -5,9 +5,14 @@
 
 #include "Emu/Cell/lv2/sys_fs.h"
 #include "Emu/Cell/lv2/sys_sync.h"
+#include "Emu/Cell/lv2/sys_ppu_thread.h"
+#include "Utilities/lockless.h"
+#include "sysPrxForUser.h"
 #include "cellFs.h"
 
 #include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 
 LOG_CHANNEL(cellFs);
 
@@ -68,10 +73,18 @@ error_code cellFsWrite(ppu_thread& ppu, u32 fd, vm::cptr<void> buf, u64 nbytes,
 	return sys_fs_write(ppu, fd, buf, nbytes, nwrite ? nwrite : vm::var<u64>{});
 }
 
+static bool fs_st_finish(u32 fd);
+
 error_code cellFsClose(ppu_thread& ppu, u32 fd)
 {
 	cellFs.trace("cellFsClose(fd=0x%x)", fd);
 
+	// Implicitly finish the stream (cellFsStReadFinish)
+	if (idm::check<lv2_fs_object, lv2_file>(fd))
+	{
+		fs_st_finish(fd);
+	}
+
 	return sys_fs_close(ppu, fd);
 }
 
@@ -676,21 +689,290 @@ error_code cellFsSetDiscReadRetrySetting()
 	return CELL_OK;
 }
 
+// Access a file at the specified offset from a host thread, returns false if the file was closed
+static bool fs_host_op_at(lv2_file& file, bool is_write, u64 offset, vm::ptr<void> buf, u64 size, u64& result)
+{
+	{
+		// Positional access doesn't interfere with the file position used by other syscalls
+		reader_lock lock(file.io_mutex);
+
+		if (!file.file)
+		{
+			return false;
+		}
+
+		result = is_write ? lv2_file::op_write_at(file.file, offset, buf, size) : lv2_file::op_read_at(file.file, offset, buf, size);
+
+		if (result != umax)
+		{
+			return true;
+		}
+	}
+
+	// Not supported by the file, seek under the mount point lock
+	std::lock_guard lock(file.mp->mutex);
+
+	if (!file.file)
+	{
+		return false;
+	}
+
+	const u64 old_pos = file.file.pos();
+	file.file.seek(offset);
+	result = is_write ? lv2_file::op_write(file.file, buf, size) : lv2_file::op_read(file.file, buf, size);
+	file.file.seek(old_pos);
+	return true;
+}
+
+struct fs_st_stream;
+
+// Host thread reading the stream data ahead into the ring buffer
+struct fs_st_reader
+{
+	fs_st_stream& st;
+	const std::shared_ptr<lv2_file> file;
+	u64 offset;
+	const u64 end;
+
+	void operator()();
+};
+
+// Stream read context of a file (cellFsStRead*)
+struct fs_st_stream
+{
+	const u32 fd;
+
+	const CellFsRingBuffer ringbuf;
+
+	// Ring buffer in guest memory
+	const u32 buf_addr;
+
+	shared_mutex mutex;
+
+	atomic_t<u64> status = CELL_FS_ST_INITIALIZED | CELL_FS_ST_STOP;
+
+	// Total amount of data read into the ring buffer and consumed by the guest
+	atomic_t<u64> wpos = 0;
+	atomic_t<u64> rpos = 0;
+
+	// Set when no more data will be read
+	atomic_t<bool> eof = true;
+
+	std::unique_ptr<named_thread<fs_st_reader>> reader;
+
+	// Pending cellFsStReadWaitCallback request
+	shared_mutex cb_mutex;
+	vm::ptr<void(s32 xfd, u64 xsize)> cb_func{};
+	u64 cb_size = 0;
+
+	fs_st_stream(u32 fd, const CellFsRingBuffer& ringbuf, u32 buf_addr)
+		: fd(fd)
+		, ringbuf(ringbuf)
+		, buf_addr(buf_addr)
+	{
+	}
+
+	u64 ring_size() const
+	{
+		return ringbuf.ringbuf_size;
+	}
+
+	void stop()
+	{
+		reader.reset();
+		status = CELL_FS_ST_INITIALIZED | CELL_FS_ST_STOP;
+		eof = true;
+		wpos.notify_all();
+
+		// Cancel the pending callback
+		std::lock_guard lock(cb_mutex);
+		cb_func = vm::null;
+	}
+
+	// Queue the pending callback if its condition is met
+	void check_callback();
+};
+
+void fs_st_reader::operator()()
+{
+	const u64 ring_size = st.ring_size();
+	const u64 block_size = st.ringbuf.block_size;
+
+	while (thread_ctrl::state() != thread_state::aborting && offset < end)
+	{
+		const u64 rpos = st.rpos;
+		const u64 wpos = st.wpos;
+
+		if (ring_size - (wpos - rpos) < block_size)
+		{
+			// Wait until the guest consumes some data
+			thread_ctrl::wait_on(st.rpos, rpos);
+			continue;
+		}
+
+		// Blocks never wrap around because the ring buffer size is a multiple of the block size
+		const u64 block = std::min<u64>(block_size, end - offset);
+
+		u64 nread = 0;
+
+		if (!fs_host_op_at(*file, false, offset, vm::cast(st.buf_addr + wpos % ring_size), block, nread))
+		{
+			break;
+		}
+
+		offset += nread;
+		st.wpos += nread;
+		st.wpos.notify_all();
+		st.check_callback();
+
+		if (nread < block)
+		{
+			break;
+		}
+	}
+
+	if (thread_ctrl::state() != thread_state::aborting)
+	{
+		st.status = CELL_FS_ST_INITIALIZED | CELL_FS_ST_STOP;
+		st.eof = true;
+		st.wpos.notify_all();
+		st.check_callback();
+	}
+}
+
+// Stream callback request (no function = terminate the callback thread)
+struct fs_st_callback
+{
+	u32 fd;
+	u64 size;
+	vm::ptr<void(s32 xfd, u64 xsize)> func;
+};
+
+struct fs_st_manager
+{
+	shared_mutex mutex;
+
+	std::unordered_map<u32, std::shared_ptr<fs_st_stream>> streams;
+
+	// Callbacks of cellFsStReadWaitCallback, executed by the HLE PPU thread
+	lf_queue<fs_st_callback> callbacks;
+
+	u32 ppu_tid = 0;
+
+	std::shared_ptr<fs_st_stream> get(u32 fd)
+	{
+		reader_lock lock(mutex);
+
+		const auto found = streams.find(fd);
+
+		if (found == streams.end())
+		{
+			return nullptr;
+		}
+
+		return found->second;
+	}
+};
+
+void fs_st_stream::check_callback()
+{
+	std::lock_guard lock(cb_mutex);
+
+	if (!cb_func)
+	{
+		return;
+	}
+
+	const u64 available = wpos - rpos;
+
+	if (available < cb_size && !eof)
+	{
+		return;
+	}
+
+	g_fxo->get<fs_st_manager>().callbacks.push(fs_st_callback{fd, available, std::exchange(cb_func, vm::null)});
+}
+
+// Tear down the stream of the file (reader thread and ring buffer), returns false if there was none
+static bool fs_st_finish(u32 fd)
+{
+	std::shared_ptr<fs_st_stream> st;
+	{
+		auto& m = g_fxo->get<fs_st_manager>();
+
+		std::lock_guard lock(m.mutex);
+
+		const auto found = m.streams.find(fd);
+
+		if (found == m.streams.end())
+		{
+			return false;
+		}
+
+		st = std::move(found->second);
+		m.streams.erase(found);
+	}
+
+	std::lock_guard lock(st->mutex);
+	st->stop();
+	vm::dealloc(st->buf_addr, vm::main);
+	return true;
+}
+
+static void fsStCallbackEntry(ppu_thread& ppu)
+{
+	auto& m = g_fxo->get<fs_st_manager>();
+
+	for (auto slice = m.callbacks.pop_all(); thread_ctrl::state() != thread_state::aborting; [&]
+	{
+		if (slice)
+		{
+			slice.pop_front();
+		}
+
+		if (slice || thread_ctrl::state() == thread_state::aborting)
+		{
+			return;
+		}
+
+		thread_ctrl::wait_on(m.callbacks, nullptr);
+		slice = m.callbacks.pop_all();
+	}())
+	{
+		const auto* cb = slice.get();
+
+		if (!cb)
+		{
+			continue;
+		}
+
+		if (!cb->func)
+		{
+			break;
+		}
+
+		cb->func(ppu, cb->fd, cb->size);
+		lv2_obj::sleep(ppu);
+	}
+
+	ppu.state += cpu_flag::exit;
+}
+
 s32 cellFsStReadInit(u32 fd, vm::cptr<CellFsRingBuffer> ringbuf)
 {
-	cellFs.todo("cellFsStReadInit(fd=%d, ringbuf=*0x%x)", fd, ringbuf);
+	cellFs.warning("cellFsStReadInit(fd=%d, ringbuf=*0x%x)", fd, ringbuf);
 
 	if (ringbuf->copy & ~CELL_FS_ST_COPYLESS)
 	{
 		return CELL_EINVAL;
 	}
 
-	if (ringbuf->block_size & 0xfff) // check if a multiple of sector size
+	if (!ringbuf->block_size || ringbuf->block_size & 0xfff) // check if a multiple of sector size
 	{
 		return CELL_EINVAL;
 	}
 
-	if (ringbuf->ringbuf_size % ringbuf->block_size) // check if a multiple of block_size
+	if (!ringbuf->ringbuf_size || ringbuf->ringbuf_size % ringbuf->block_size) // check if a multiple of block_size
 	{
 		return CELL_EINVAL;
 	}
@@ -707,14 +989,34 @@ s32 cellFsStReadInit(u32 fd, vm::cptr<CellFsRingBuffer> ringbuf)
 		return CELL_EPERM;
 	}
 
-	// TODO
+	auto& m = g_fxo->get<fs_st_manager>();
+
+	std::lock_guard lock(m.mutex);
+
+	if (m.streams.count(fd))
+	{
+		return CELL_EBUSY;
+	}
 
+	if (ringbuf->ringbuf_size > u32{umax})
+	{
+		return CELL_ENOMEM;
+	}
+
+	const u32 buf_addr = vm::alloc(static_cast<u32>(ringbuf->ringbuf_size), vm::main, 0x1000);
+
+	if (!buf_addr)
+	{
+		return CELL_ENOMEM;
+	}
+
+	m.streams.emplace(fd, std::make_shared<fs_st_stream>(fd, *ringbuf, buf_addr));
 	return CELL_OK;
 }
 
 s32 cellFsStReadFinish(u32 fd)
 {
-	cellFs.todo("cellFsStReadFinish(fd=%d)", fd);
+	cellFs.warning("cellFsStReadFinish(fd=%d)", fd);
 
 	const auto file = idm::get<lv2_fs_object, lv2_file>(fd);
 
@@ -723,14 +1025,17 @@ s32 cellFsStReadFinish(u32 fd)
 		return CELL_EBADF; // ???
 	}
 
-	// TODO
+	if (!fs_st_finish(fd))
+	{
+		return CELL_ENXIO;
+	}
 
 	return CELL_OK;
 }
 
 s32 cellFsStReadGetRingBuf(u32 fd, vm::ptr<CellFsRingBuffer> ringbuf)
 {
-	cellFs.todo("cellFsStReadGetRingBuf(fd=%d, ringbuf=*0x%x)", fd, ringbuf);
+	cellFs.trace("cellFsStReadGetRingBuf(fd=%d, ringbuf=*0x%x)", fd, ringbuf);
 
 	const auto file = idm::get<lv2_fs_object, lv2_file>(fd);
 
@@ -739,14 +1044,25 @@ s32 cellFsStReadGetRingBuf(u32 fd, vm::ptr<CellFsRingBuffer> ringbuf)
 		return CELL_EBADF;
 	}
 
-	// TODO
+	const auto st = g_fxo->get<fs_st_manager>().get(fd);
+
+	if (!st)
+	{
+		return CELL_ENXIO;
+	}
 
+	if (!ringbuf)
+	{
+		return CELL_EFAULT;
+	}
+
+	*ringbuf = st->ringbuf;
 	return CELL_OK;
 }
 
 s32 cellFsStReadGetStatus(u32 fd, vm::ptr<u64> status)
 {
-	cellFs.todo("cellFsStReadGetRingBuf(fd=%d, status=*0x%x)", fd, status);
+	cellFs.trace("cellFsStReadGetStatus(fd=%d, status=*0x%x)", fd, status);
 
 	const auto file = idm::get<lv2_fs_object, lv2_file>(fd);
 
@@ -755,14 +1071,20 @@ s32 cellFsStReadGetStatus(u32 fd, vm::ptr<u64> status)
 		return CELL_EBADF;
 	}
 
-	// TODO
+	if (!status)
+	{
+		return CELL_EFAULT;
+	}
+
+	const auto st = g_fxo->get<fs_st_manager>().get(fd);
 
+	*status = st ? st->status.load() : u64{CELL_FS_ST_NOT_INITIALIZED | CELL_FS_ST_STOP};
 	return CELL_OK;
 }
 
 s32 cellFsStReadGetRegid(u32 fd, vm::ptr<u64> regid)
 {
-	cellFs.todo("cellFsStReadGetRingBuf(fd=%d, regid=*0x%x)", fd, regid);
+	cellFs.todo("cellFsStReadGetRegid(fd=%d, regid=*0x%x)", fd, regid);
 
 	const auto file = idm::get<lv2_fs_object, lv2_file>(fd);
 
@@ -778,7 +1100,7 @@ s32 cellFsStReadGetRegid(u32 fd, vm::ptr<u64> regid)
 
 s32 cellFsStReadStart(u32 fd, u64 offset, u64 size)
 {
-	cellFs.todo("cellFsStReadStart(fd=%d, offset=0x%llx, size=0x%llx)", fd, offset, size);
+	cellFs.warning("cellFsStReadStart(fd=%d, offset=0x%llx, size=0x%llx)", fd, offset, size);
 
 	const auto file = idm::get<lv2_fs_object, lv2_file>(fd);
 
@@ -787,14 +1109,38 @@ s32 cellFsStReadStart(u32 fd, u64 offset, u64 size)
 		return CELL_EBADF;
 	}
 
-	// TODO
+	const auto st = g_fxo->get<fs_st_manager>().get(fd);
+
+	if (!st)
+	{
+		return CELL_ENXIO;
+	}
+
+	u64 file_size = 0;
+
+	if (std::lock_guard lock(file->mp->mutex); file->file)
+	{
+		file_size = file->file.size();
+	}
 
+	std::lock_guard lock(st->mutex);
+
+	// Restart the stream
+	st->stop();
+	st->rpos = 0;
+	st->wpos = 0;
+
+	const u64 end = offset >= file_size ? offset : std::min<u64>(file_size, size ? offset + size : file_size);
+
+	st->eof = false;
+	st->status = CELL_FS_ST_INITIALIZED | CELL_FS_ST_PROGRESS;
+	st->reader = std::make_unique<named_thread<fs_st_reader>>(fmt::format("FS Stream Reader %d", fd), fs_st_reader{*st, file, offset, end});
 	return CELL_OK;
 }
 
 s32 cellFsStReadStop(u32 fd)
 {
-	cellFs.todo("cellFsStReadStop(fd=%d)", fd);
+	cellFs.warning("cellFsStReadStop(fd=%d)", fd);
 
 	const auto file = idm::get<lv2_fs_object, lv2_file>(fd);
 
@@ -803,14 +1149,21 @@ s32 cellFsStReadStop(u32 fd)
 		return CELL_EBADF;
 	}
 
-	// TODO
+	const auto st = g_fxo->get<fs_st_manager>().get(fd);
 
+	if (!st)
+	{
+		return CELL_ENXIO;
+	}
+
+	std::lock_guard lock(st->mutex);
+	st->stop();
 	return CELL_OK;
 }
 
 s32 cellFsStRead(u32 fd, vm::ptr<u8> buf, u64 size, vm::ptr<u64> rsize)
 {
-	cellFs.todo("cellFsStRead(fd=%d, buf=*0x%x, size=0x%llx, rsize=*0x%x)", fd, buf, size, rsize);
+	cellFs.trace("cellFsStRead(fd=%d, buf=*0x%x, size=0x%llx, rsize=*0x%x)", fd, buf, size, rsize);
 
 	const auto file = idm::get<lv2_fs_object, lv2_file>(fd);
 
@@ -819,14 +1172,37 @@ s32 cellFsStRead(u32 fd, vm::ptr<u8> buf, u64 size, vm::ptr<u64> rsize)
 		return CELL_EBADF;
 	}
 
-	// TODO
+	const auto st = g_fxo->get<fs_st_manager>().get(fd);
+
+	if (!st)
+	{
+		return CELL_ENXIO;
+	}
+
+	if (!buf || !rsize)
+	{
+		return CELL_EFAULT;
+	}
 
+	const u64 ring_size = st->ring_size();
+	const u64 rpos = st->rpos;
+	const u64 count = std::min<u64>(size, st->wpos - rpos);
+
+	// Copy available data (may wrap around)
+	const u64 first = std::min<u64>(count, ring_size - rpos % ring_size);
+	std::memcpy(buf.get_ptr(), vm::base(st->buf_addr + static_cast<u32>(rpos % ring_size)), first);
+	std::memcpy(buf.get_ptr() + first, vm::base(st->buf_addr), count - first);
+
+	st->rpos += count;
+	st->rpos.notify_all();
+
+	*rsize = count;
 	return CELL_OK;
 }
 
 s32 cellFsStReadGetCurrentAddr(u32 fd, vm::ptr<u32> addr, vm::ptr<u64> size)
 {
-	cellFs.todo("cellFsStReadGetCurrentAddr(fd=%d, addr=*0x%x, size=*0x%x)", fd, addr, size);
+	cellFs.trace("cellFsStReadGetCurrentAddr(fd=%d, addr=*0x%x, size=*0x%x)", fd, addr, size);
 
 	const auto file = idm::get<lv2_fs_object, lv2_file>(fd);
 
@@ -835,14 +1211,30 @@ s32 cellFsStReadGetCurrentAddr(u32 fd, vm::ptr<u32> addr, vm::ptr<u64> size)
 		return CELL_EBADF;
 	}
 
-	// TODO
+	const auto st = g_fxo->get<fs_st_manager>().get(fd);
+
+	if (!st)
+	{
+		return CELL_ENXIO;
+	}
+
+	if (!addr || !size)
+	{
+		return CELL_EFAULT;
+	}
 
+	// Contiguous part of the available data
+	const u64 ring_size = st->ring_size();
+	const u64 rpos = st->rpos;
+
+	*addr = st->buf_addr + static_cast<u32>(rpos % ring_size);
+	*size = std::min<u64>(st->wpos - rpos, ring_size - rpos % ring_size);
 	return CELL_OK;
 }
 
 s32 cellFsStReadPutCurrentAddr(u32 fd, vm::ptr<u8> addr, u64 size)
 {
-	cellFs.todo("cellFsStReadPutCurrentAddr(fd=%d, addr=*0x%x, size=0x%llx)", fd, addr, size);
+	cellFs.trace("cellFsStReadPutCurrentAddr(fd=%d, addr=*0x%x, size=0x%llx)", fd, addr, size);
 
 	const auto file = idm::get<lv2_fs_object, lv2_file>(fd);
 
@@ -851,14 +1243,54 @@ s32 cellFsStReadPutCurrentAddr(u32 fd, vm::ptr<u8> addr, u64 size)
 		return CELL_EBADF;
 	}
 
-	// TODO
+	const auto st = g_fxo->get<fs_st_manager>().get(fd);
+
+	if (!st)
+	{
+		return CELL_ENXIO;
+	}
 
+	const u64 rpos = st->rpos;
+
+	if (addr.addr() != st->buf_addr + rpos % st->ring_size() || size > st->wpos - rpos)
+	{
+		return CELL_EINVAL;
+	}
+
+	st->rpos += size;
+	st->rpos.notify_all();
 	return CELL_OK;
 }
 
-s32 cellFsStReadWait(u32 fd, u64 size)
+// Wait until the specified amount of data is available or the stream ends
+static error_code fs_st_wait(ppu_thread& ppu, fs_st_stream& st, u64 size)
 {
-	cellFs.todo("cellFsStReadWait(fd=%d, size=0x%llx)", fd, size);
+	lv2_obj::sleep(ppu);
+
+	while (true)
+	{
+		const bool eof = st.eof;
+		const u64 wpos = st.wpos;
+
+		if (wpos - st.rpos >= size || eof)
+		{
+			break;
+		}
+
+		thread_ctrl::wait_on(st.wpos, wpos, 10000);
+
+		if (ppu.is_stopped())
+		{
+			return {};
+		}
+	}
+
+	return CELL_OK;
+}
+
+error_code cellFsStReadWait(ppu_thread& ppu, u32 fd, u64 size)
+{
+	cellFs.trace("cellFsStReadWait(fd=%d, size=0x%llx)", fd, size);
 
 	const auto file = idm::get<lv2_fs_object, lv2_file>(fd);
 
@@ -867,14 +1299,24 @@ s32 cellFsStReadWait(u32 fd, u64 size)
 		return CELL_EBADF;
 	}
 
-	// TODO
+	const auto st = g_fxo->get<fs_st_manager>().get(fd);
 
-	return CELL_OK;
+	if (!st)
+	{
+		return CELL_ENXIO;
+	}
+
+	if (size > st->ring_size())
+	{
+		return CELL_EINVAL;
+	}
+
+	return fs_st_wait(ppu, *st, size);
 }
 
-s32 cellFsStReadWaitCallback(u32 fd, u64 size, vm::ptr<void(s32 xfd, u64 xsize)> func)
+error_code cellFsStReadWaitCallback(ppu_thread& ppu, u32 fd, u64 size, vm::ptr<void(s32 xfd, u64 xsize)> func)
 {
-	cellFs.todo("cellFsStReadWaitCallback(fd=%d, size=0x%llx, func=*0x%x)", fd, size, func);
+	cellFs.warning("cellFsStReadWaitCallback(fd=%d, size=0x%llx, func=*0x%x)", fd, size, func);
 
 	const auto file = idm::get<lv2_fs_object, lv2_file>(fd);
 
@@ -883,137 +1325,310 @@ s32 cellFsStReadWaitCallback(u32 fd, u64 size, vm::ptr<void(s32 xfd, u64 xsize)>
 		return CELL_EBADF;
 	}
 
-	// TODO
+	const auto st = g_fxo->get<fs_st_manager>().get(fd);
 
-	return CELL_OK;
-}
+	if (!st)
+	{
+		return CELL_ENXIO;
+	}
 
-using fs_aio_cb_t = vm::ptr<void(vm::ptr<CellFsAio> xaio, s32 error, s32 xid, u64 size)>;
+	if (size > st->ring_size())
+	{
+		return CELL_EINVAL;
+	}
 
-struct fs_aio_thread : ppu_thread
-{
-	using ppu_thread::ppu_thread;
+	auto& m = g_fxo->get<fs_st_manager>();
 
-	void non_task()
+	if (func)
 	{
-		while (cmd64 cmd = cmd_wait())
-		{
-			const u32 type = cmd.arg1<u32>();
-			const s32 xid = cmd.arg2<s32>();
-			const cmd64 cmd2 = cmd_get(1);
-			const auto aio = cmd2.arg1<vm::ptr<CellFsAio>>();
-			const auto func = cmd2.arg2<fs_aio_cb_t>();
-			cmd_pop(1);
-
-			s32 error = CELL_EBADF;
-			u64 result = 0;
+		std::lock_guard lock(m.mutex);
 
-			const auto file = idm::get<lv2_fs_object, lv2_file>(aio->fd);
+		if (!m.ppu_tid)
+		{
+			// Create callback thread
+			vm::var<u64> _tid;
+			vm::var<char[]> _name = vm::make_str("HLE FS Stream");
 
-			if (!file || (type == 1 && file->flags & CELL_FS_O_WRONLY) || (type == 2 && !(file->flags & CELL_FS_O_ACCMODE)))
+			if (error_code res = ppu_execute<&sys_ppu_thread_create>(ppu, +_tid, 0x10000, 0, 1001, 0x4000, SYS_PPU_THREAD_CREATE_INTERRUPT, +_name))
 			{
+				return res;
 			}
-			else if (std::lock_guard lock(file->mp->mutex); file->file)
-			{
-				const auto old_pos = file->file.pos(); file->file.seek(aio->offset);
 
-				result = type == 2
-					? file->op_write(aio->buf, aio->size)
-					: file->op_read(aio->buf, aio->size);
+			m.ppu_tid = static_cast<u32>(*_tid);
 
-				file->file.seek(old_pos);
-				error = CELL_OK;
-			}
+			const auto thrd = idm::get<named_thread<ppu_thread>>(m.ppu_tid);
+
+			thrd->cmd_list
+			({
+				{ ppu_cmd::hle_call, FIND_FUNC(fsStCallbackEntry) },
+			});
+
+			thrd->state -= cpu_flag::stop;
+			thrd->state.notify_one(cpu_flag::stop);
+		}
+	}
+
+	{
+		std::lock_guard lock(st->cb_mutex);
 
-			func(*this, aio, error, xid, result);
-			lv2_obj::sleep(*this);
+		if (st->cb_func)
+		{
+			return CELL_EBUSY;
 		}
+
+		st->cb_func = func;
+		st->cb_size = size;
 	}
+
+	// The callback is called from the callback thread once the data is available
+	st->check_callback();
+	return CELL_OK;
+}
+
+using fs_aio_cb_t = vm::ptr<void(vm::ptr<CellFsAio> xaio, s32 error, s32 xid, u64 size)>;
+
+// AIO request (type: 1 = read, 2 = write, 0 = terminate the callback thread)
+struct fs_aio_request
+{
+	u32 type;
+	s32 xid;
+	vm::ptr<CellFsAio> aio;
+	fs_aio_cb_t func;
+	s32 error = CELL_EBADF;
+	u64 result = 0;
+};
+
+// Host thread executing AIO requests
+struct fs_aio_worker
+{
+	lf_queue<fs_aio_request> requests;
+
+	void operator()();
 };
 
 struct fs_aio_manager
 {
-	std::shared_ptr<fs_aio_thread> thread;
+	static constexpr u32 worker_count = 4;
 
 	shared_mutex mutex;
+
+	// Host workers (multiple outstanding requests are served concurrently)
+	std::unique_ptr<named_thread_group<fs_aio_worker>> workers;
+
+	u32 worker_index = 0;
+
+	// Requests not yet started (used for cancellation)
+	std::unordered_set<s32> pending;
+
+	// Completed requests, their callbacks are executed by the HLE PPU thread
+	lf_queue<fs_aio_request> completed;
+
+	u32 ppu_tid = 0;
 };
 
-s32 cellFsAioInit(vm::cptr<char> mount_point)
+void fs_aio_worker::operator()()
 {
-	cellFs.warning("cellFsAioInit(mount_point=%s)", mount_point);
+	auto& m = g_fxo->get<fs_aio_manager>();
+
+	while (thread_ctrl::state() != thread_state::aborting)
+	{
+		for (auto req : requests.pop_all())
+		{
+			bool cancelled = false;
+			{
+				std::lock_guard lock(m.mutex);
+				cancelled = !m.pending.erase(req.xid);
+			}
 
-	// TODO: create AIO thread (if not exists) for specified mount point
-	cellFs.fatal("cellFsAio disabled, use LLE.");
+			const auto file = cancelled ? nullptr : idm::get<lv2_fs_object, lv2_file>(req.aio->fd);
 
-	return CELL_OK;
+			if (cancelled)
+			{
+				req.error = CELL_ECANCELED;
+			}
+			else if (!file || (req.type == 1 && file->flags & CELL_FS_O_WRONLY) || (req.type == 2 && !(file->flags & CELL_FS_O_ACCMODE)))
+			{
+			}
+			else if (fs_host_op_at(*file, req.type == 2, req.aio->offset, req.aio->buf, req.aio->size, req.result))
+			{
+				req.error = CELL_OK;
+			}
+
+			m.completed.push(req);
+		}
+
+		thread_ctrl::wait_on(requests, nullptr);
+	}
 }
 
-s32 cellFsAioFinish(vm::cptr<char> mount_point)
+static void fsAioEntry(ppu_thread& ppu)
 {
-	cellFs.warning("cellFsAioFinish(mount_point=%s)", mount_point);
+	auto& m = g_fxo->get<fs_aio_manager>();
 
-	// TODO: delete existing AIO thread for specified mount point
+	for (auto slice = m.completed.pop_all(); thread_ctrl::state() != thread_state::aborting; [&]
+	{
+		if (slice)
+		{
+			slice.pop_front();
+		}
 
-	return CELL_OK;
-}
+		if (slice || thread_ctrl::state() == thread_state::aborting)
+		{
+			return;
+		}
 
-atomic_t<s32> g_fs_aio_id;
+		thread_ctrl::wait_on(m.completed, nullptr);
+		slice = m.completed.pop_all();
+	}())
+	{
+		const auto* req = slice.get();
 
-s32 cellFsAioRead(vm::ptr<CellFsAio> aio, vm::ptr<s32> id, fs_aio_cb_t func)
-{
-	cellFs.warning("cellFsAioRead(aio=*0x%x, id=*0x%x, func=*0x%x)", aio, id, func);
+		if (!req)
+		{
+			continue;
+		}
+
+		if (!req->type)
+		{
+			break;
+		}
 
-	// TODO: detect mount point and send AIO request to the AIO thread of this mount point
+		if (req->func)
+		{
+			req->func(ppu, req->aio, req->error, req->xid, req->result);
+			lv2_obj::sleep(ppu);
+		}
+	}
 
+	ppu.state += cpu_flag::exit;
+}
+
+error_code cellFsAioInit(ppu_thread& ppu, vm::cptr<char> mount_point)
+{
+	cellFs.warning("cellFsAioInit(mount_point=%s)", mount_point);
+
+	// TODO: separate AIO context for each mount point
 	auto& m = g_fxo->get<fs_aio_manager>();
 
-	if (!m.thread)
+	std::lock_guard lock(m.mutex);
+
+	if (m.ppu_tid)
 	{
-		return CELL_ENXIO;
+		return CELL_OK;
 	}
 
-	const s32 xid = (*id = ++g_fs_aio_id);
+	m.workers = std::make_unique<named_thread_group<fs_aio_worker>>("FS AIO Worker ", fs_aio_manager::worker_count);
+
+	// Create callback thread
+	vm::var<u64> _tid;
+	vm::var<char[]> _name = vm::make_str("HLE FS AIO");
+
+	if (error_code res = ppu_execute<&sys_ppu_thread_create>(ppu, +_tid, 0x10000, 0, 1001, 0x4000, SYS_PPU_THREAD_CREATE_INTERRUPT, +_name))
+	{
+		m.workers.reset();
+		return res;
+	}
 
-	m.thread->cmd_list
+	m.ppu_tid = static_cast<u32>(*_tid);
+
+	const auto thrd = idm::get<named_thread<ppu_thread>>(m.ppu_tid);
+
+	thrd->cmd_list
 	({
-		{ 1, xid },
-		{ aio, func },
+		{ ppu_cmd::hle_call, FIND_FUNC(fsAioEntry) },
 	});
 
+	thrd->state -= cpu_flag::stop;
+	thrd->state.notify_one(cpu_flag::stop);
+
 	return CELL_OK;
 }
 
-s32 cellFsAioWrite(vm::ptr<CellFsAio> aio, vm::ptr<s32> id, fs_aio_cb_t func)
+error_code cellFsAioFinish(ppu_thread& ppu, vm::cptr<char> mount_point)
 {
-	cellFs.warning("cellFsAioWrite(aio=*0x%x, id=*0x%x, func=*0x%x)", aio, id, func);
+	cellFs.warning("cellFsAioFinish(mount_point=%s)", mount_point);
 
-	// TODO: detect mount point and send AIO request to the AIO thread of this mount point
+	// TODO: delete existing AIO context for specified mount point
+	auto& m = g_fxo->get<fs_aio_manager>();
+
+	std::unique_ptr<named_thread_group<fs_aio_worker>> workers;
+	u32 tid = 0;
+	{
+		std::lock_guard lock(m.mutex);
 
+		workers = std::move(m.workers);
+		tid = std::exchange(m.ppu_tid, 0);
+		m.pending.clear();
+	}
+
+	if (!tid)
+	{
+		return CELL_OK;
+	}
+
+	// Stop host workers (unstarted requests are dropped)
+	workers.reset();
+
+	// Terminate callback thread
+	m.completed.push(fs_aio_request{});
+	ppu_execute<&sys_interrupt_thread_disestablish>(ppu, tid);
+
+	return CELL_OK;
+}
+
+atomic_t<s32> g_fs_aio_id;
+
+static s32 fs_aio_submit(u32 type, vm::ptr<CellFsAio> aio, vm::ptr<s32> id, fs_aio_cb_t func)
+{
+	// TODO: detect mount point and send AIO request to the AIO context of this mount point
 	auto& m = g_fxo->get<fs_aio_manager>();
 
-	if (!m.thread)
+	std::lock_guard lock(m.mutex);
+
+	if (!m.workers)
 	{
 		return CELL_ENXIO;
 	}
 
 	const s32 xid = (*id = ++g_fs_aio_id);
 
-	m.thread->cmd_list
-	({
-		{ 2, xid },
-		{ aio, func },
-	});
+	m.pending.emplace(xid);
+
+	// Distribute requests among the workers
+	(m.workers->begin() + (m.worker_index++ % fs_aio_manager::worker_count))->requests.push(fs_aio_request{type, xid, aio, func});
 
 	return CELL_OK;
 }
 
+s32 cellFsAioRead(vm::ptr<CellFsAio> aio, vm::ptr<s32> id, fs_aio_cb_t func)
+{
+	cellFs.warning("cellFsAioRead(aio=*0x%x, id=*0x%x, func=*0x%x)", aio, id, func);
+
+	return fs_aio_submit(1, aio, id, func);
+}
+
+s32 cellFsAioWrite(vm::ptr<CellFsAio> aio, vm::ptr<s32> id, fs_aio_cb_t func)
+{
+	cellFs.warning("cellFsAioWrite(aio=*0x%x, id=*0x%x, func=*0x%x)", aio, id, func);
+
+	return fs_aio_submit(2, aio, id, func);
+}
+
 s32 cellFsAioCancel(s32 id)
 {
-	cellFs.todo("cellFsAioCancel(id=%d) -> CELL_EINVAL", id);
+	cellFs.warning("cellFsAioCancel(id=%d)", id);
 
-	// TODO: cancelled requests return CELL_ECANCELED through their own callbacks
+	auto& m = g_fxo->get<fs_aio_manager>();
+
+	std::lock_guard lock(m.mutex);
 
-	return CELL_EINVAL;
+	// Cancelled requests return CELL_ECANCELED through their own callbacks
+	if (!m.pending.erase(id))
+	{
+		return CELL_EINVAL;
+	}
+
+	return CELL_OK;
 }
 
 s32 cellFsArcadeHddSerialNumber()
@@ -1116,4 +1731,7 @@ DECLARE(ppu_module_manager::cellFs)("sys_fs", []()
 	REG_FUNC(sys_fs, cellFsUtime);
 	REG_FUNC(sys_fs, cellFsWrite).flag(MFF_PERFECT);
 	REG_FUNC(sys_fs, cellFsWriteWithOffset);
+
+	REG_HIDDEN_FUNC(fsAioEntry);
+	REG_HIDDEN_FUNC(fsStCallbackEntry);
 });
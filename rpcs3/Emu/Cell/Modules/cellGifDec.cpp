@@ -3,11 +3,9 @@
 #include "Emu/IdManager.h"
 #include "Emu/Cell/PPUModule.h"
 
-// STB_IMAGE_IMPLEMENTATION is already defined in stb_image.cpp
-#include <stb_image.h>
-
 #include "Emu/Cell/lv2/sys_fs.h"
 #include "cellGifDec.h"
+#include "image_decoder.h"
 
 #include "util/asm.hpp"
 
@@ -80,6 +78,9 @@ error_code cellGifDecOpen(PMainHandle mainHandle, PPSubHandle subHandle, PSrc sr
 	{
 	case CELL_GIFDEC_BUFFER:
 		current_subHandle.fileSize = src->streamSize;
+
+		// Start decoding early on a host thread, DecodeData picks up the result
+		image_decoder::prefetch({static_cast<const u8*>(src->streamPtr.get_ptr()), static_cast<const u8*>(src->streamPtr.get_ptr()) + src->streamSize});
 		break;
 
 	case CELL_GIFDEC_FILE:
@@ -90,6 +91,9 @@ error_code cellGifDecOpen(PMainHandle mainHandle, PPSubHandle subHandle, PSrc sr
 		if (!file_s) return CELL_GIFDEC_ERROR_OPEN_FILE;
 
 		current_subHandle.fileSize = file_s.size();
+		image_decoder::prefetch(file_s.to_vector<u8>());
+		file_s.seek(0);
+
 		current_subHandle.fd = idm::make<lv2_fs_object, lv2_file>(src->fileName.get_ptr(), std::move(file_s), 0, 0, real_path);
 		break;
 	}
@@ -204,102 +208,48 @@ error_code cellGifDecDecodeData(PMainHandle mainHandle, PSubHandle subHandle, vm
 	const CellGifDecOutParam& current_outParam = subHandle->outParam;
 
 	//Copy the GIF file to a buffer
-	std::unique_ptr<u8[]> gif(new u8[fileSize]);
+	std::vector<u8> gif(fileSize);
 
 	switch (subHandle->src.srcSelect)
 	{
 	case CELL_GIFDEC_BUFFER:
-		std::memcpy(gif.get(), subHandle->src.streamPtr.get_ptr(), fileSize);
+		std::memcpy(gif.data(), subHandle->src.streamPtr.get_ptr(), fileSize);
 		break;
 
 	case CELL_GIFDEC_FILE:
 	{
 		auto file = idm::get<lv2_fs_object, lv2_file>(fd);
 		file->file.seek(0);
-		file->file.read(gif.get(), fileSize);
+		file->file.read(gif.data(), fileSize);
 		break;
 	}
 	default: break; // TODO
 	}
 
-	//Decode GIF file. (TODO: Is there any faster alternative? Can we do it without external libraries?)
-	int width, height, actual_components;
-	auto image = std::unique_ptr<unsigned char,decltype(&::free)>
-		(
-			stbi_load_from_memory(gif.get(), ::narrow<int>(fileSize), &width, &height, &actual_components, 4),
-			&::free
-		);
-
-	if (!image)
-		return CELL_GIFDEC_ERROR_STREAM_FORMAT;
-
-	const int bytesPerLine = static_cast<int>(dataCtrlParam->outputBytesPerLine);
-	const char nComponents = 4;
-	uint image_size = width * height * nComponents;
+	image_decoder::output_format format{};
 
-	switch(current_outParam.outputColorSpace)
+	switch (current_outParam.outputColorSpace)
 	{
 	case CELL_GIFDEC_RGBA:
-	{
-		if (bytesPerLine > width * nComponents) // Check if we need padding
-		{
-			const int linesize = std::min(bytesPerLine, width * nComponents);
-			for (int i = 0; i < height; i++)
-			{
-				const int dstOffset = i * bytesPerLine;
-				const int srcOffset = width * nComponents * i;
-				memcpy(&data[dstOffset], &image.get()[srcOffset], linesize);
-			}
-		}
-		else
-		{
-			memcpy(data.get_ptr(), image.get(), image_size);
-		}
-	}
-	break;
+		format = image_decoder::output_format::rgba;
+		break;
 
 	case CELL_GIFDEC_ARGB:
-	{
-		if (bytesPerLine > width * nComponents) // Check if we need padding
-		{
-			//TODO: find out if we can't do padding without an extra copy
-			const int linesize = std::min(bytesPerLine, width * nComponents);
-			const auto output = std::make_unique<char[]>(linesize);
-			for (int i = 0; i < height; i++)
-			{
-				const int dstOffset = i * bytesPerLine;
-				const int srcOffset = width * nComponents * i;
-				for (int j = 0; j < linesize; j += nComponents)
-				{
-					output[j + 0] = image.get()[srcOffset + j + 3];
-					output[j + 1] = image.get()[srcOffset + j + 0];
-					output[j + 2] = image.get()[srcOffset + j + 1];
-					output[j + 3] = image.get()[srcOffset + j + 2];
-				}
-				std::memcpy(&data[dstOffset], output.get(), linesize);
-			}
-		}
-		else
-		{
-			const auto img = std::make_unique<uint[]>(image_size);
-			uint* source_current = reinterpret_cast<uint*>(image.get());
-			uint* dest_current = img.get();
-			for (uint i = 0; i < image_size / nComponents; i++)
-			{
-				uint val = *source_current;
-				*dest_current = (val >> 24) | (val << 8); // set alpha (A8) as leftmost byte
-				source_current++;
-				dest_current++;
-			}
-			std::memcpy(data.get_ptr(), img.get(), image_size);
-		}
-	}
-	break;
+		format = image_decoder::output_format::argb;
+		break;
 
 	default:
 		return CELL_GIFDEC_ERROR_ARG;
 	}
 
+	// Decoded on a host worker if prefetched by Open, otherwise here (cached by content)
+	const auto image = image_decoder::decode(std::move(gif));
+
+	if (!image)
+		return CELL_GIFDEC_ERROR_STREAM_FORMAT;
+
+	image_decoder::write(*image, data.get_ptr(), dataCtrlParam->outputBytesPerLine, format, false);
+
 	dataOutInfo->status = CELL_GIFDEC_DEC_STATUS_FINISH;
 	dataOutInfo->recordType = CELL_GIFDEC_RECORD_TYPE_IMAGE_DESC;
 
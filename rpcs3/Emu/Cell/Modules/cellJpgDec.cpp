@@ -3,11 +3,9 @@
 #include "Emu/IdManager.h"
 #include "Emu/Cell/PPUModule.h"
 
-// STB_IMAGE_IMPLEMENTATION is already defined in stb_image.cpp
-#include <stb_image.h>
-
 #include "Emu/Cell/lv2/sys_fs.h"
 #include "cellJpgDec.h"
+#include "image_decoder.h"
 
 #include "util/asm.hpp"
 
@@ -71,6 +69,9 @@ error_code cellJpgDecOpen(u32 mainHandle, vm::ptr<u32> subHandle, vm::ptr<CellJp
 	{
 	case CELL_JPGDEC_BUFFER:
 		current_subHandle.fileSize = src->streamSize;
+
+		// Start decoding early on a host thread, DecodeData picks up the result
+		image_decoder::prefetch({vm::_ptr<u8>(src->streamPtr), vm::_ptr<u8>(src->streamPtr) + src->streamSize});
 		break;
 
 	case CELL_JPGDEC_FILE:
@@ -81,6 +82,9 @@ error_code cellJpgDecOpen(u32 mainHandle, vm::ptr<u32> subHandle, vm::ptr<CellJp
 		if (!file_s) return CELL_JPGDEC_ERROR_OPEN_FILE;
 
 		current_subHandle.fileSize = file_s.size();
+		image_decoder::prefetch(file_s.to_vector<u8>());
+		file_s.seek(0);
+
 		current_subHandle.fd = idm::make<lv2_fs_object, lv2_file>(src->fileName.get_ptr(), std::move(file_s), 0, 0, real_path);
 		break;
 	}
@@ -213,102 +217,41 @@ error_code cellJpgDecDecodeData(u32 mainHandle, u32 subHandle, vm::ptr<u8> data,
 	const CellJpgDecOutParam& current_outParam = subHandle_data->outParam;
 
 	//Copy the JPG file to a buffer
-	std::unique_ptr<u8[]> jpg(new u8[fileSize]);
+	std::vector<u8> jpg(fileSize);
 
 	switch (subHandle_data->src.srcSelect)
 	{
 	case CELL_JPGDEC_BUFFER:
-		std::memcpy(jpg.get(), vm::base(subHandle_data->src.streamPtr), fileSize);
+		std::memcpy(jpg.data(), vm::base(subHandle_data->src.streamPtr), fileSize);
 		break;
 
 	case CELL_JPGDEC_FILE:
 	{
 		auto file = idm::get<lv2_fs_object, lv2_file>(fd);
 		file->file.seek(0);
-		file->file.read(jpg.get(), fileSize);
+		file->file.read(jpg.data(), fileSize);
 		break;
 	}
 	default: break; // TODO
 	}
 
-	//Decode JPG file. (TODO: Is there any faster alternative? Can we do it without external libraries?)
-	int width, height, actual_components;
-	auto image = std::unique_ptr<unsigned char,decltype(&::free)>
-		(
-			stbi_load_from_memory(jpg.get(), ::narrow<int>(fileSize), &width, &height, &actual_components, 4),
-			&::free
-		);
-
-	if (!image)
-		return CELL_JPGDEC_ERROR_STREAM_FORMAT;
-
-	const bool flip = current_outParam.outputMode == CELL_JPGDEC_BOTTOM_TO_TOP;
-	const int bytesPerLine = static_cast<int>(dataCtrlParam->outputBytesPerLine);
-	usz image_size = width * height;
+	image_decoder::output_format format{};
+	u32 nComponents = 4;
 
-	switch(current_outParam.outputColorSpace)
+	switch (current_outParam.outputColorSpace)
 	{
 	case CELL_JPG_RGB:
+		format = image_decoder::output_format::rgb;
+		nComponents = 3;
+		break;
+
 	case CELL_JPG_RGBA:
-	{
-		const char nComponents = current_outParam.outputColorSpace == CELL_JPG_RGBA ? 4 : 3;
-		image_size *= nComponents;
-		if (bytesPerLine > width * nComponents || flip) //check if we need padding
-		{
-			const int linesize = std::min(bytesPerLine, width * nComponents);
-			for (int i = 0; i < height; i++)
-			{
-				const int dstOffset = i * bytesPerLine;
-				const int srcOffset = width * nComponents * (flip ? height - i - 1 : i);
-				memcpy(&data[dstOffset], &image.get()[srcOffset], linesize);
-			}
-		}
-		else
-		{
-			memcpy(data.get_ptr(), image.get(), image_size);
-		}
-	}
-	break;
+		format = image_decoder::output_format::rgba;
+		break;
 
 	case CELL_JPG_ARGB:
-	{
-		const int nComponents = 4;
-		image_size *= nComponents;
-		if (bytesPerLine > width * nComponents || flip) //check if we need padding
-		{
-			//TODO: Find out if we can't do padding without an extra copy
-			const int linesize = std::min(bytesPerLine, width * nComponents);
-			const auto output = std::make_unique<char[]>(linesize);
-			for (int i = 0; i < height; i++)
-			{
-				const int dstOffset = i * bytesPerLine;
-				const int srcOffset = width * nComponents * (flip ? height - i - 1 : i);
-				for (int j = 0; j < linesize; j += nComponents)
-				{
-					output[j + 0] = image.get()[srcOffset + j + 3];
-					output[j + 1] = image.get()[srcOffset + j + 0];
-					output[j + 2] = image.get()[srcOffset + j + 1];
-					output[j + 3] = image.get()[srcOffset + j + 2];
-				}
-				std::memcpy(&data[dstOffset], output.get(), linesize);
-			}
-		}
-		else
-		{
-			const auto img = std::make_unique<uint[]>(image_size);
-			uint* source_current = reinterpret_cast<uint*>(image.get());
-			uint* dest_current = img.get();
-			for (uint i = 0; i < image_size / nComponents; i++)
-			{
-				uint val = *source_current;
-				*dest_current = (val >> 24) | (val << 8); // set alpha (A8) as leftmost byte
-				source_current++;
-				dest_current++;
-			}
-			std::memcpy(data.get_ptr(), img.get(), image_size);
-		}
-	}
-	break;
+		format = image_decoder::output_format::argb;
+		break;
 
 	case CELL_JPG_GRAYSCALE:
 	case CELL_JPG_YCbCr:
@@ -316,12 +259,24 @@ error_code cellJpgDecDecodeData(u32 mainHandle, u32 subHandle, vm::ptr<u8> data,
 	case CELL_JPG_GRAYSCALE_TO_ALPHA_RGBA:
 	case CELL_JPG_GRAYSCALE_TO_ALPHA_ARGB:
 		cellJpgDec.error("cellJpgDecDecodeData: Unsupported color space (%d)", current_outParam.outputColorSpace);
-	break;
+		dataOutInfo->status = CELL_JPGDEC_DEC_STATUS_FINISH;
+		return CELL_OK;
 
 	default:
 		return CELL_JPGDEC_ERROR_ARG;
 	}
 
+	// Decoded on a host worker if prefetched by Open, otherwise here (cached by content)
+	const auto image = image_decoder::decode(std::move(jpg));
+
+	if (!image)
+		return CELL_JPGDEC_ERROR_STREAM_FORMAT;
+
+	const bool flip = current_outParam.outputMode == CELL_JPGDEC_BOTTOM_TO_TOP;
+	const usz image_size = usz{image->width} * image->height * nComponents;
+
+	image_decoder::write(*image, data.get_ptr(), dataCtrlParam->outputBytesPerLine, format, flip);
+
 	dataOutInfo->status = CELL_JPGDEC_DEC_STATUS_FINISH;
 
 	if(dataCtrlParam->outputBytesPerLine)
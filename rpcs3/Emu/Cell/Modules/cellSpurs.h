@@ -113,6 +113,7 @@ enum SPURSKernelInterfaces : u32
 	CELL_SPURS_KERNEL2_EXIT_ADDR            = 0x838,
 	CELL_SPURS_KERNEL1_SELECT_WORKLOAD_ADDR = 0x290,
 	CELL_SPURS_KERNEL2_SELECT_WORKLOAD_ADDR = 0x290,
+	SPURS_HLE_SELECT_WORKLOAD_STOP_CODE     = 0x3ffe, // Replaces the first instruction of the kernel workload selection in HLE scheduler mode
 };
 
 enum RangeofEventQueuePortNumbers
@@ -1112,6 +1113,14 @@ struct alignas(128) spurs_wkl_state_op
 	u8 wklEvent2[0x10];                 // 0x70
 };
 
+// Scheduling line of CellSpurs (0x00..0x7F) updated atomically by the SPURS kernel workload selection
+struct alignas(128) spurs_kernel_sched_op
+{
+	u8 data[0x80];
+};
+
+CHECK_SIZE_ALIGN(spurs_kernel_sched_op, 128, 128);
+
 struct alignas(128) CellSpursTaskset2
 {
 	struct TaskInfo
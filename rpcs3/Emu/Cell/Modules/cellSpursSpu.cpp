@@ -1,6 +1,7 @@
 #include "stdafx.h"
 #include "Loader/ELF.h"
 
+#include "Emu/system_config.h"
 #include "Emu/Memory/vm_reservation.h"
 #include "Emu/Cell/SPUThread.h"
 #include "Emu/Cell/SPURecompiler.h"
@@ -274,10 +275,10 @@ bool spursKernel1SelectWorkload(spu_thread& spu)
 	u32 wklSelectedId;
 	u32 pollStatus;
 
-	//vm::reservation_op(vm::cast(ctxt->spurs.addr()), 128, [&]()
+	// Atomically update the first 0x80 bytes of spurs (the scheduling line), notifying SPUs waiting on it
+	vm::reservation_op<true>(spu, vm::unsafe_ptr_cast<spurs_kernel_sched_op>(ctxt->spurs), [&](spurs_kernel_sched_op& op)
 	{
-		// lock the first 0x80 bytes of spurs
-		auto spurs = ctxt->spurs.get_ptr();
+		const auto spurs = reinterpret_cast<CellSpurs*>(&op);
 
 		// Calculate the contention (number of SPUs used) for each workload
 		u8 contention[CELL_SPURS_MAX_WORKLOAD];
@@ -437,7 +438,7 @@ bool spursKernel1SelectWorkload(spu_thread& spu)
 		}
 
 		std::memcpy(ctxt, spurs, 128);
-	}//);
+	});
 
 	u64 result = u64{wklSelectedId} << 32;
 	result |= pollStatus;
@@ -458,10 +459,10 @@ bool spursKernel2SelectWorkload(spu_thread& spu)
 	u32 wklSelectedId;
 	u32 pollStatus;
 
-	//vm::reservation_op(vm::cast(ctxt->spurs.addr()), 128, [&]()
+	// Atomically update the first 0x80 bytes of spurs (the scheduling line), notifying SPUs waiting on it
+	vm::reservation_op<true>(spu, vm::unsafe_ptr_cast<spurs_kernel_sched_op>(ctxt->spurs), [&](spurs_kernel_sched_op& op)
 	{
-		// lock the first 0x80 bytes of spurs
-		auto spurs = ctxt->spurs.get_ptr();
+		const auto spurs = reinterpret_cast<CellSpurs*>(&op);
 
 		// Calculate the contention (number of SPUs used) for each workload
 		u8 contention[CELL_SPURS_MAX_WORKLOAD2];
@@ -610,7 +611,7 @@ bool spursKernel2SelectWorkload(spu_thread& spu)
 		}
 
 		std::memcpy(ctxt, spurs, 128);
-	}//);
+	});
 
 	u64 result = u64{wklSelectedId} << 32;
 	result |= pollStatus;
@@ -737,6 +738,67 @@ bool spursKernelEntry(spu_thread& spu)
 	return false;
 }
 
+// HLE scheduler mode: replace the workload selection of an LLE SPURS kernel just loaded to LS (called on thread group start)
+void spursKernelPatchHle(spu_thread& spu, u32 entry, u32 group_id)
+{
+	spu.spurs_hle_kernel = 0;
+
+	if (!g_cfg.core.spurs_hle_scheduler || (entry != CELL_SPURS_KERNEL1_ENTRY_ADDR && entry != CELL_SPURS_KERNEL2_ENTRY_ADDR))
+	{
+		return;
+	}
+
+	// The kernel is started with the SPU number and the SPURS address as arguments, they must describe this very thread
+	const u32 spu_num = spu.gpr[3]._u32[3];
+	const u64 spurs_addr = spu.gpr[4]._u64[1];
+	const bool is_kernel2 = entry == CELL_SPURS_KERNEL2_ENTRY_ADDR;
+
+	if (spu_num >= 8 || spurs_addr % 128 || spurs_addr >> 32 || !vm::check_addr(static_cast<u32>(spurs_addr), vm::page_readable, sizeof(CellSpurs)))
+	{
+		return;
+	}
+
+	const auto spurs = vm::_ptr<CellSpurs>(static_cast<u32>(spurs_addr));
+
+	if (spurs->spuTG != group_id || spurs->spus[spu_num] != spu.lv2_id || !!(spurs->flags1 & SF1_32_WORKLOADS) != is_kernel2)
+	{
+		cellSpurs.warning("HLE scheduler: SPU thread 0x%x is not a SPURS kernel of 0x%x, running LLE", spu.lv2_id, spurs_addr);
+		return;
+	}
+
+	// The selector is entered with brsl/bisl, trap on its first instruction
+	spu._ref<u32>(is_kernel2 ? CELL_SPURS_KERNEL2_SELECT_WORKLOAD_ADDR : CELL_SPURS_KERNEL1_SELECT_WORKLOAD_ADDR) = SPURS_HLE_SELECT_WORKLOAD_STOP_CODE;
+	spu.spurs_hle_kernel = is_kernel2 ? 2 : 1;
+
+	cellSpurs.notice("HLE scheduler: SPURS kernel%u workload selection patched on SPU thread 0x%x (spurs=0x%x)", spu.spurs_hle_kernel, spu.lv2_id, spurs_addr);
+}
+
+// HLE scheduler mode: STOP handler of the patched workload selection, returns false if the STOP is not ours
+bool spursKernelHleStop(spu_thread& spu, u32 code)
+{
+	const bool is_kernel2 = spu.spurs_hle_kernel == 2;
+
+	if (code != SPURS_HLE_SELECT_WORKLOAD_STOP_CODE || spu.pc != (is_kernel2 ? CELL_SPURS_KERNEL2_SELECT_WORKLOAD_ADDR : CELL_SPURS_KERNEL1_SELECT_WORKLOAD_ADDR))
+	{
+		return false;
+	}
+
+	const u32 link = spu.gpr[0]._u32[3];
+
+	if (is_kernel2)
+	{
+		spursKernel2SelectWorkload(spu);
+	}
+	else
+	{
+		spursKernel1SelectWorkload(spu);
+	}
+
+	// Return to the caller (result in $3)
+	spu.pc = link & 0x3fffc;
+	return true;
+}
+
 //----------------------------------------------------------------------------
 // SPURS system workload functions
 //----------------------------------------------------------------------------
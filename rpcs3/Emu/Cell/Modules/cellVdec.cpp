@@ -5,8 +5,12 @@
 #include "Emu/Cell/lv2/sys_sync.h"
 #include "Emu/Cell/lv2/sys_ppu_thread.h"
 #include "Emu/Cell/lv2/sys_process.h"
+#include "Emu/system_config.h"
 #include "sysPrxForUser.h"
 #include "util/media_utils.h"
+#include "util/sysinfo.hpp"
+#include "util/v128.hpp"
+#include "util/simd.hpp"
 
 #ifdef _MSC_VER
 #pragma warning(push, 0)
@@ -203,6 +207,10 @@ struct vdec_context final
 	std::deque<vdec_frame> out_queue;
 	const u32 out_max = 60;
 
+	// Userdata and attribute of the recently sent AUs, indexed by AVPacket::pos
+	std::array<std::pair<u64, CellVdecPicAttr>, 64> au_info{};
+	u64 au_index = 0;
+
 	atomic_t<u32> au_count{0};
 
 	lf_queue<vdec_cmd> in_cmd;
@@ -251,6 +259,12 @@ struct vdec_context final
 			fmt::throw_exception("avcodec_alloc_context3() failed (type=0x%x)", type);
 		}
 
+		// Decode on multiple host threads, the guest thread only submits AUs and collects pictures.
+		// Frame threading holds back one picture per extra thread, so it is only used when explicitly enabled.
+		const u32 thread_count = g_cfg.video.vdec_threads;
+		ctx->thread_count = thread_count ? thread_count : std::min<u32>(utils::get_thread_count(), 4);
+		ctx->thread_type = g_cfg.video.vdec_frame_threading ? FF_THREAD_FRAME | FF_THREAD_SLICE : FF_THREAD_SLICE;
+
 		AVDictionary* opts = nullptr;
 
 		std::lock_guard lock(g_mutex_avcodec_open2);
@@ -283,6 +297,193 @@ struct vdec_context final
 		sws_freeContext(sws);
 	}
 
+	// Receive all pictures available from the decoder
+	void receive_frames(const vdec_cmd& cmd, std::deque<vdec_frame>& decoded_frames)
+	{
+		while (!abort_decode && seq_id == cmd.seq_id)
+		{
+			// Keep receiving frames
+			vdec_frame frame;
+			frame.seq_id = cmd.seq_id;
+			frame.cmd_id = cmd.id;
+			frame.avf.reset(av_frame_alloc());
+
+			if (!frame.avf)
+			{
+				fmt::throw_exception("av_frame_alloc() failed (handle=0x%x, seq_id=%d, cmd_id=%d)", handle, cmd.seq_id, cmd.id);
+			}
+
+			if (int ret = avcodec_receive_frame(ctx, frame.avf.get()); ret < 0)
+			{
+				if (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF)
+				{
+					break;
+				}
+
+				fmt::throw_exception("AU decoding error (handle=0x%x, seq_id=%d, cmd_id=%d, error=0x%x): %s", handle, cmd.seq_id, cmd.id, ret, utils::av_error_to_string(ret));
+			}
+
+			if (frame->interlaced_frame)
+			{
+				// NPEB01838, NPUB31260
+				cellVdec.todo("Interlaced frames not supported (handle=0x%x, seq_id=%d, cmd_id=%d, interlaced_frame=0x%x)", handle, cmd.seq_id, cmd.id, frame->interlaced_frame);
+			}
+
+			if (frame->repeat_pict)
+			{
+				fmt::throw_exception("Repeated frames not supported (handle=0x%x, seq_id=%d, cmd_id=%d, repear_pict=0x%x)", handle, cmd.seq_id, cmd.id, frame->repeat_pict);
+			}
+
+			if (frame->pts != smin)
+			{
+				next_pts = frame->pts;
+			}
+
+			if (frame->pkt_dts != smin)
+			{
+				next_dts = frame->pkt_dts;
+			}
+
+			frame.pts = next_pts;
+			frame.dts = next_dts;
+
+			// Find the AU this picture has been decoded from (pictures may be delayed by reordering or frame threading)
+			if (const s64 index = frame->pkt_pos; index >= 0 && static_cast<u64>(index) < au_index && au_index - index <= au_info.size())
+			{
+				std::tie(frame.userdata, frame.attr) = au_info[index % au_info.size()];
+			}
+			else
+			{
+				std::tie(frame.userdata, frame.attr) = au_info[(au_index - 1) % au_info.size()];
+			}
+
+			if (frc_set)
+			{
+				u64 amend = 0;
+
+				switch (frc_set)
+				{
+				case CELL_VDEC_FRC_24000DIV1001: amend = 1001 * 90000 / 24000; break;
+				case CELL_VDEC_FRC_24: amend = 90000 / 24; break;
+				case CELL_VDEC_FRC_25: amend = 90000 / 25; break;
+				case CELL_VDEC_FRC_30000DIV1001: amend = 1001 * 90000 / 30000; break;
+				case CELL_VDEC_FRC_30: amend = 90000 / 30; break;
+				case CELL_VDEC_FRC_50: amend = 90000 / 50; break;
+				case CELL_VDEC_FRC_60000DIV1001: amend = 1001 * 90000 / 60000; break;
+				case CELL_VDEC_FRC_60: amend = 90000 / 60; break;
+				default:
+				{
+					fmt::throw_exception("Invalid frame rate code set (handle=0x%x, seq_id=%d, cmd_id=%d, frc=0x%x)", handle, cmd.seq_id, cmd.id, frc_set);
+				}
+				}
+
+				next_pts += amend;
+				next_dts += amend;
+				frame.frc = frc_set;
+			}
+			else if (ctx->time_base.num == 0)
+			{
+				if (log_time_base.den != ctx->time_base.den || log_time_base.num != ctx->time_base.num)
+				{
+					cellVdec.error("time_base.num is 0 (handle=0x%x, seq_id=%d, cmd_id=%d, %d/%d, tpf=%d framerate=%d/%d)", handle, cmd.seq_id, cmd.id, ctx->time_base.num, ctx->time_base.den, ctx->ticks_per_frame, ctx->framerate.num, ctx->framerate.den);
+					log_time_base = ctx->time_base;
+				}
+
+				// Hack
+				const u64 amend = u64{90000} / 30;
+				frame.frc = CELL_VDEC_FRC_30;
+				next_pts += amend;
+				next_dts += amend;
+			}
+			else
+			{
+				u64 amend = u64{90000} * ctx->time_base.num * ctx->ticks_per_frame / ctx->time_base.den;
+				const auto freq = 1. * ctx->time_base.den / ctx->time_base.num / ctx->ticks_per_frame;
+
+				if (std::abs(freq - 23.976) < 0.002)
+					frame.frc = CELL_VDEC_FRC_24000DIV1001;
+				else if (std::abs(freq - 24.000) < 0.001)
+					frame.frc = CELL_VDEC_FRC_24;
+				else if (std::abs(freq - 25.000) < 0.001)
+					frame.frc = CELL_VDEC_FRC_25;
+				else if (std::abs(freq - 29.970) < 0.002)
+					frame.frc = CELL_VDEC_FRC_30000DIV1001;
+				else if (std::abs(freq - 30.000) < 0.001)
+					frame.frc = CELL_VDEC_FRC_30;
+				else if (std::abs(freq - 50.000) < 0.001)
+					frame.frc = CELL_VDEC_FRC_50;
+				else if (std::abs(freq - 59.940) < 0.002)
+					frame.frc = CELL_VDEC_FRC_60000DIV1001;
+				else if (std::abs(freq - 60.000) < 0.001)
+					frame.frc = CELL_VDEC_FRC_60;
+				else
+				{
+					if (log_time_base.den != ctx->time_base.den || log_time_base.num != ctx->time_base.num)
+					{
+						// 1/1000 usually means that the time stamps are written in 1ms units and that the frame rate may vary.
+						cellVdec.error("Unsupported time_base (handle=0x%x, seq_id=%d, cmd_id=%d, %d/%d, tpf=%d framerate=%d/%d)", handle, cmd.seq_id, cmd.id, ctx->time_base.num, ctx->time_base.den, ctx->ticks_per_frame, ctx->framerate.num, ctx->framerate.den);
+						log_time_base = ctx->time_base;
+					}
+
+					// Hack
+					amend = u64{90000} / 30;
+					frame.frc = CELL_VDEC_FRC_30;
+				}
+
+				next_pts += amend;
+				next_dts += amend;
+			}
+
+			cellVdec.trace("Got picture (handle=0x%x, seq_id=%d, cmd_id=%d, pts=0x%llx[0x%llx], dts=0x%llx[0x%llx])", handle, cmd.seq_id, cmd.id, frame.pts, frame->pts, frame.dts, frame->pkt_dts);
+
+			decoded_frames.push_back(std::move(frame));
+		}
+	}
+
+	// Move decoded pictures to the output queue (waits for free space) and send PICOUT for each of them
+	void output_frames(ppu_thread& ppu, u32 vid, const vdec_cmd& cmd, std::deque<vdec_frame>& decoded_frames)
+	{
+		while (!decoded_frames.empty() && seq_id == cmd.seq_id)
+		{
+			// Wait until there is free space in the image queue.
+			// Do this after pushing the frame to the queue. That way the game can consume the frame and we can move on.
+			u32 elapsed = 0;
+			while (thread_ctrl::state() != thread_state::aborting && !abort_decode && seq_id == cmd.seq_id)
+			{
+				{
+					std::lock_guard lock{mutex};
+
+					if (out_queue.size() <= out_max)
+					{
+						break;
+					}
+				}
+				thread_ctrl::wait_for(1000);
+
+				if (elapsed++ >= 5000) // 5 seconds
+				{
+					cellVdec.error("Video au decode has been waiting for a consumer for 5 seconds. (handle=0x%x, seq_id=%d, cmd_id=%d, queue_size=%d)", handle, cmd.seq_id, cmd.id, out_queue.size());
+					elapsed = 0;
+				}
+			}
+
+			if (thread_ctrl::state() == thread_state::aborting || abort_decode || seq_id != cmd.seq_id)
+			{
+				break;
+			}
+
+			{
+				std::lock_guard lock{mutex};
+				out_queue.push_back(std::move(decoded_frames.front()));
+				decoded_frames.pop_front();
+			}
+
+			cellVdec.trace("Sending CELL_VDEC_MSG_TYPE_PICOUT (handle=0x%x, seq_id=%d, cmd_id=%d)", handle, cmd.seq_id, cmd.id);
+			cb_func(ppu, vid, CELL_VDEC_MSG_TYPE_PICOUT, CELL_OK, cb_arg);
+			lv2_obj::sleep(ppu);
+		}
+	}
+
 	void exec(ppu_thread& ppu, u32 vid)
 	{
 		perf_meter<"VDEC"_u32> perf0;
@@ -346,6 +547,23 @@ struct vdec_context final
 			{
 				cellVdec.trace("End sequence... (handle=0x%x, seq_id=%d, cmd_id=%d)", handle, cmd->seq_id, cmd->id);
 
+				if (!abort_decode && seq_id == cmd->seq_id && au_index)
+				{
+					// Drain the pictures still held by the decoder (reordering and frame threading delay)
+					std::deque<vdec_frame> decoded_frames;
+
+					if (int ret = avcodec_send_packet(ctx, nullptr); ret < 0)
+					{
+						fmt::throw_exception("AU draining error (handle=0x%x, seq_id=%d, cmd_id=%d, error=0x%x): %s", handle, cmd->seq_id, cmd->id, ret, utils::av_error_to_string(ret));
+					}
+
+					receive_frames(*cmd, decoded_frames);
+					output_frames(ppu, vid, *cmd, decoded_frames);
+
+					// Leave the draining mode
+					avcodec_flush_buffers(ctx);
+				}
+
 				{
 					std::lock_guard lock{mutex};
 					seq_state = sequence_state::dormant;
@@ -359,7 +577,6 @@ struct vdec_context final
 			case vdec_cmd_type::au_decode:
 			{
 				AVPacket packet{};
-				packet.pos = -1;
 
 				u64 au_usrd{};
 
@@ -395,6 +612,9 @@ struct vdec_context final
 
 				if (!abort_decode && seq_id == cmd->seq_id)
 				{
+					packet.pos = au_index;
+					au_info[au_index++ % au_info.size()] = {au_usrd, attr};
+
 					cellVdec.trace("AU decoding: handle=0x%x, seq_id=%d, cmd_id=%d, size=0x%x, pts=0x%llx, dts=0x%llx, userdata=0x%llx", handle, cmd->seq_id, cmd->id, au_size, au_pts, au_dts, au_usrd);
 
 					if (int ret = avcodec_send_packet(ctx, &packet); ret < 0)
@@ -402,136 +622,7 @@ struct vdec_context final
 						fmt::throw_exception("AU queuing error (handle=0x%x, seq_id=%d, cmd_id=%d, error=0x%x): %s", handle, cmd->seq_id, cmd->id, ret, utils::av_error_to_string(ret));
 					}
 
-					while (!abort_decode && seq_id == cmd->seq_id)
-					{
-						// Keep receiving frames
-						vdec_frame frame;
-						frame.seq_id = cmd->seq_id;
-						frame.cmd_id = cmd->id;
-						frame.avf.reset(av_frame_alloc());
-
-						if (!frame.avf)
-						{
-							fmt::throw_exception("av_frame_alloc() failed (handle=0x%x, seq_id=%d, cmd_id=%d)", handle, cmd->seq_id, cmd->id);
-						}
-
-						if (int ret = avcodec_receive_frame(ctx, frame.avf.get()); ret < 0)
-						{
-							if (ret == AVERROR(EAGAIN) || ret == AVERROR(EOF))
-							{
-								break;
-							}
-
-							fmt::throw_exception("AU decoding error (handle=0x%x, seq_id=%d, cmd_id=%d, error=0x%x): %s", handle, cmd->seq_id, cmd->id, ret, utils::av_error_to_string(ret));
-						}
-
-						if (frame->interlaced_frame)
-						{
-							// NPEB01838, NPUB31260
-							cellVdec.todo("Interlaced frames not supported (handle=0x%x, seq_id=%d, cmd_id=%d, interlaced_frame=0x%x)", handle, cmd->seq_id, cmd->id, frame->interlaced_frame);
-						}
-
-						if (frame->repeat_pict)
-						{
-							fmt::throw_exception("Repeated frames not supported (handle=0x%x, seq_id=%d, cmd_id=%d, repear_pict=0x%x)", handle, cmd->seq_id, cmd->id, frame->repeat_pict);
-						}
-
-						if (frame->pts != smin)
-						{
-							next_pts = frame->pts;
-						}
-
-						if (frame->pkt_dts != smin)
-						{
-							next_dts = frame->pkt_dts;
-						}
-
-						frame.pts = next_pts;
-						frame.dts = next_dts;
-						frame.userdata = au_usrd;
-						frame.attr = attr;
-
-						if (frc_set)
-						{
-							u64 amend = 0;
-
-							switch (frc_set)
-							{
-							case CELL_VDEC_FRC_24000DIV1001: amend = 1001 * 90000 / 24000; break;
-							case CELL_VDEC_FRC_24: amend = 90000 / 24; break;
-							case CELL_VDEC_FRC_25: amend = 90000 / 25; break;
-							case CELL_VDEC_FRC_30000DIV1001: amend = 1001 * 90000 / 30000; break;
-							case CELL_VDEC_FRC_30: amend = 90000 / 30; break;
-							case CELL_VDEC_FRC_50: amend = 90000 / 50; break;
-							case CELL_VDEC_FRC_60000DIV1001: amend = 1001 * 90000 / 60000; break;
-							case CELL_VDEC_FRC_60: amend = 90000 / 60; break;
-							default:
-							{
-								fmt::throw_exception("Invalid frame rate code set (handle=0x%x, seq_id=%d, cmd_id=%d, frc=0x%x)", handle, cmd->seq_id, cmd->id, frc_set);
-							}
-							}
-
-							next_pts += amend;
-							next_dts += amend;
-							frame.frc = frc_set;
-						}
-						else if (ctx->time_base.num == 0)
-						{
-							if (log_time_base.den != ctx->time_base.den || log_time_base.num != ctx->time_base.num)
-							{
-								cellVdec.error("time_base.num is 0 (handle=0x%x, seq_id=%d, cmd_id=%d, %d/%d, tpf=%d framerate=%d/%d)", handle, cmd->seq_id, cmd->id, ctx->time_base.num, ctx->time_base.den, ctx->ticks_per_frame, ctx->framerate.num, ctx->framerate.den);
-								log_time_base = ctx->time_base;
-							}
-
-							// Hack
-							const u64 amend = u64{90000} / 30;
-							frame.frc = CELL_VDEC_FRC_30;
-							next_pts += amend;
-							next_dts += amend;
-						}
-						else
-						{
-							u64 amend = u64{90000} * ctx->time_base.num * ctx->ticks_per_frame / ctx->time_base.den;
-							const auto freq = 1. * ctx->time_base.den / ctx->time_base.num / ctx->ticks_per_frame;
-
-							if (std::abs(freq - 23.976) < 0.002)
-								frame.frc = CELL_VDEC_FRC_24000DIV1001;
-							else if (std::abs(freq - 24.000) < 0.001)
-								frame.frc = CELL_VDEC_FRC_24;
-							else if (std::abs(freq - 25.000) < 0.001)
-								frame.frc = CELL_VDEC_FRC_25;
-							else if (std::abs(freq - 29.970) < 0.002)
-								frame.frc = CELL_VDEC_FRC_30000DIV1001;
-							else if (std::abs(freq - 30.000) < 0.001)
-								frame.frc = CELL_VDEC_FRC_30;
-							else if (std::abs(freq - 50.000) < 0.001)
-								frame.frc = CELL_VDEC_FRC_50;
-							else if (std::abs(freq - 59.940) < 0.002)
-								frame.frc = CELL_VDEC_FRC_60000DIV1001;
-							else if (std::abs(freq - 60.000) < 0.001)
-								frame.frc = CELL_VDEC_FRC_60;
-							else
-							{
-								if (log_time_base.den != ctx->time_base.den || log_time_base.num != ctx->time_base.num)
-								{
-									// 1/1000 usually means that the time stamps are written in 1ms units and that the frame rate may vary.
-									cellVdec.error("Unsupported time_base (handle=0x%x, seq_id=%d, cmd_id=%d, %d/%d, tpf=%d framerate=%d/%d)", handle, cmd->seq_id, cmd->id, ctx->time_base.num, ctx->time_base.den, ctx->ticks_per_frame, ctx->framerate.num, ctx->framerate.den);
-									log_time_base = ctx->time_base;
-								}
-
-								// Hack
-								amend = u64{90000} / 30;
-								frame.frc = CELL_VDEC_FRC_30;
-							}
-
-							next_pts += amend;
-							next_dts += amend;
-						}
-
-						cellVdec.trace("Got picture (handle=0x%x, seq_id=%d, cmd_id=%d, pts=0x%llx[0x%llx], dts=0x%llx[0x%llx])", handle, cmd->seq_id, cmd->id, frame.pts, frame->pts, frame.dts, frame->pkt_dts);
-
-						decoded_frames.push_back(std::move(frame));
-					}
+					receive_frames(*cmd, decoded_frames);
 				}
 
 				if (thread_ctrl::state() != thread_state::aborting)
@@ -546,45 +637,7 @@ struct vdec_context final
 						--au_count;
 					}
 
-					while (!decoded_frames.empty() && seq_id == cmd->seq_id)
-					{
-						// Wait until there is free space in the image queue.
-						// Do this after pushing the frame to the queue. That way the game can consume the frame and we can move on.
-						u32 elapsed = 0;
-						while (thread_ctrl::state() != thread_state::aborting && !abort_decode && seq_id == cmd->seq_id)
-						{
-							{
-								std::lock_guard lock{mutex};
-
-								if (out_queue.size() <= out_max)
-								{
-									break;
-								}
-							}
-							thread_ctrl::wait_for(1000);
-
-							if (elapsed++ >= 5000) // 5 seconds
-							{
-								cellVdec.error("Video au decode has been waiting for a consumer for 5 seconds. (handle=0x%x, seq_id=%d, cmd_id=%d, queue_size=%d)", handle, cmd->seq_id, cmd->id, out_queue.size());
-								elapsed = 0;
-							}
-						}
-
-						if (thread_ctrl::state() == thread_state::aborting || abort_decode || seq_id != cmd->seq_id)
-						{
-							break;
-						}
-
-						{
-							std::lock_guard lock{mutex};
-							out_queue.push_back(std::move(decoded_frames.front()));
-							decoded_frames.pop_front();
-						}
-
-						cellVdec.trace("Sending CELL_VDEC_MSG_TYPE_PICOUT (handle=0x%x, seq_id=%d, cmd_id=%d)", handle, cmd->seq_id, cmd->id);
-						cb_func(ppu, vid, CELL_VDEC_MSG_TYPE_PICOUT, CELL_OK, cb_arg);
-						lv2_obj::sleep(ppu);
-					}
+					output_frames(ppu, vid, *cmd, decoded_frames);
 				}
 
 				if (abort_decode || seq_id != cmd->seq_id)
@@ -1129,6 +1182,144 @@ error_code cellVdecDecodeAuEx2(u32 handle, CellVdecDecodeMode mode, vm::cptr<Cel
 	return CELL_OK;
 }
 
+// Fixed point YUV to RGB conversion coefficients
+struct vdec_yuv_coefs
+{
+	s16 y_off; // Black level
+	s16 y;     // Luma scale (Q14)
+	s16 v_r;   // Chroma factors (Q13)
+	s16 u_g;
+	s16 v_g;
+	s16 u_b;
+
+	static vdec_yuv_coefs get(bool bt709, bool full_range)
+	{
+		const f64 kr = bt709 ? 0.2126 : 0.299;
+		const f64 kb = bt709 ? 0.0722 : 0.114;
+		const f64 kg = 1. - kr - kb;
+		const f64 y_scale = full_range ? 1. : 255. / 219.;
+		const f64 c_scale = full_range ? 1. : 255. / 224.;
+
+		const auto q = [](f64 value, int bits)
+		{
+			return static_cast<s16>(std::lround(value * (1 << bits)));
+		};
+
+		vdec_yuv_coefs result;
+		result.y_off = full_range ? 0 : 16;
+		result.y = q(y_scale, 14);
+		result.v_r = q(2. * (1. - kr) * c_scale, 13);
+		result.u_g = q(2. * (1. - kb) * kb / kg * c_scale, 13);
+		result.v_g = q(2. * (1. - kr) * kr / kg * c_scale, 13);
+		result.u_b = q(2. * (1. - kb) * c_scale, 13);
+		return result;
+	}
+};
+
+// Convert YUV420P to 32-bit RGBA or ARGB (nearest chroma sample, like SWS_POINT).
+// Intermediate values are in Q6: luma is pre-shifted by 7 and chroma by 8 before the Q15 multiplication.
+static void vdec_yuv420_to_rgb32(const AVFrame* frame, u8* dst, u8 alpha, bool argb, const vdec_yuv_coefs& k)
+{
+	const u32 w = frame->width;
+	const u32 h = frame->height;
+
+	const v128 zero{};
+	const v128 a = v128::from8p(alpha);
+	const v128 y_off = gv_bcst16(static_cast<u16>(k.y_off << 7));
+	const v128 c_off = gv_bcst16(128);
+	const v128 round = gv_bcst16(32);
+	const v128 k_y = gv_bcst16(k.y);
+	const v128 k_vr = gv_bcst16(k.v_r);
+	const v128 k_ug = gv_bcst16(k.u_g);
+	const v128 k_vg = gv_bcst16(k.v_g);
+	const v128 k_ub = gv_bcst16(k.u_b);
+
+	const auto to_u8 = [&](const v128& lo, const v128& hi)
+	{
+		return gv_packus_s16(gv_sar16(gv_adds_s16(lo, round), 6), gv_sar16(gv_adds_s16(hi, round), 6));
+	};
+
+	for (u32 row = 0; row < h; row++)
+	{
+		const u8* src_y = frame->data[0] + usz{row} * frame->linesize[0];
+		const u8* src_u = frame->data[1] + usz{row / 2} * frame->linesize[1];
+		const u8* src_v = frame->data[2] + usz{row / 2} * frame->linesize[2];
+		u8* out = dst + usz{row} * w * 4;
+
+		u32 x = 0;
+
+		for (; x + 16 <= w; x += 16, out += 64)
+		{
+			const v128 y8 = v128::loadu(src_y + x);
+
+			// Load 8 chroma samples and duplicate each of them horizontally
+			v128 u8x{};
+			v128 v8x{};
+			std::memcpy(&u8x, src_u + x / 2, 8);
+			std::memcpy(&v8x, src_v + x / 2, 8);
+			const v128 u16x = gv_unpacklo8(u8x, u8x);
+			const v128 v16x = gv_unpacklo8(v8x, v8x);
+
+			v128 r[2], g[2], b[2];
+
+			for (u32 i = 0; i < 2; i++)
+			{
+				const v128 yw = i ? gv_unpackhi8(y8, zero) : gv_unpacklo8(y8, zero);
+				const v128 uw = i ? gv_unpackhi8(u16x, zero) : gv_unpacklo8(u16x, zero);
+				const v128 vw = i ? gv_unpackhi8(v16x, zero) : gv_unpacklo8(v16x, zero);
+
+				const v128 yt = gv_muls_hds16(gv_sub16(gv_shl16(yw, 7), y_off), k_y);
+				const v128 us = gv_shl16(gv_sub16(uw, c_off), 8);
+				const v128 vs = gv_shl16(gv_sub16(vw, c_off), 8);
+
+				r[i] = gv_adds_s16(yt, gv_muls_hds16(vs, k_vr));
+				g[i] = gv_subs_s16(gv_subs_s16(yt, gv_muls_hds16(us, k_ug)), gv_muls_hds16(vs, k_vg));
+				b[i] = gv_adds_s16(yt, gv_muls_hds16(us, k_ub));
+			}
+
+			const v128 r8 = to_u8(r[0], r[1]);
+			const v128 g8 = to_u8(g[0], g[1]);
+			const v128 b8 = to_u8(b[0], b[1]);
+
+			// Interleave the components
+			const v128 p0 = argb ? gv_unpacklo8(a, r8) : gv_unpacklo8(r8, g8);
+			const v128 p1 = argb ? gv_unpackhi8(a, r8) : gv_unpackhi8(r8, g8);
+			const v128 q0 = argb ? gv_unpacklo8(g8, b8) : gv_unpacklo8(b8, a);
+			const v128 q1 = argb ? gv_unpackhi8(g8, b8) : gv_unpackhi8(b8, a);
+
+			v128::storeu(gv_unpacklo16(p0, q0), out, 0);
+			v128::storeu(gv_unpackhi16(p0, q0), out, 1);
+			v128::storeu(gv_unpacklo16(p1, q1), out, 2);
+			v128::storeu(gv_unpackhi16(p1, q1), out, 3);
+		}
+
+		for (; x < w; x++, out += 4)
+		{
+			const s32 yt = ((src_y[x] - k.y_off) * 128 * k.y) >> 15;
+			const s32 us = (src_u[x / 2] - 128) * 256;
+			const s32 vs = (src_v[x / 2] - 128) * 256;
+
+			const auto clamp = [](s32 v)
+			{
+				return static_cast<u8>(std::clamp((v + 32) >> 6, 0, 255));
+			};
+
+			const u8 r8 = clamp(yt + ((vs * k.v_r) >> 15));
+			const u8 g8 = clamp(yt - ((us * k.u_g) >> 15) - ((vs * k.v_g) >> 15));
+			const u8 b8 = clamp(yt + ((us * k.u_b) >> 15));
+
+			if (argb)
+			{
+				out[0] = alpha, out[1] = r8, out[2] = g8, out[3] = b8;
+			}
+			else
+			{
+				out[0] = r8, out[1] = g8, out[2] = b8, out[3] = alpha;
+			}
+		}
+	}
+}
+
 error_code cellVdecGetPictureExt(u32 handle, vm::cptr<CellVdecPicFormat2> format, vm::ptr<u8> outBuff, u32 arg4)
 {
 	cellVdec.trace("cellVdecGetPictureExt(handle=0x%x, format=*0x%x, outBuff=*0x%x, arg4=*0x%x)", handle, format, outBuff, arg4);
@@ -1202,12 +1393,12 @@ error_code cellVdecGetPictureExt(u32 handle, vm::cptr<CellVdecPicFormat2> format
 
 		AVPixelFormat out_f = AV_PIX_FMT_YUV420P;
 
-		std::unique_ptr<u8[]> alpha_plane;
+		bool rgb32 = false;
 
 		switch (const u32 type = format->formatType)
 		{
-		case CELL_VDEC_PICFMT_ARGB32_ILV: out_f = AV_PIX_FMT_ARGB; alpha_plane.reset(new u8[w * h]); break;
-		case CELL_VDEC_PICFMT_RGBA32_ILV: out_f = AV_PIX_FMT_RGBA; alpha_plane.reset(new u8[w * h]); break;
+		case CELL_VDEC_PICFMT_ARGB32_ILV: out_f = AV_PIX_FMT_ARGB; rgb32 = true; break;
+		case CELL_VDEC_PICFMT_RGBA32_ILV: out_f = AV_PIX_FMT_RGBA; rgb32 = true; break;
 		case CELL_VDEC_PICFMT_UYVY422_ILV: out_f = AV_PIX_FMT_UYVY422; break;
 		case CELL_VDEC_PICFMT_YUV420_PLANAR: out_f = AV_PIX_FMT_YUV420P; break;
 		default:
@@ -1216,39 +1407,35 @@ error_code cellVdecGetPictureExt(u32 handle, vm::cptr<CellVdecPicFormat2> format
 		}
 		}
 
-		// TODO: color matrix
-
-		if (alpha_plane)
-		{
-			std::memset(alpha_plane.get(), format->alpha, w * h);
-		}
-
-		AVPixelFormat in_f = AV_PIX_FMT_YUV420P;
-
 		switch (frame->format)
 		{
 		case AV_PIX_FMT_YUVJ420P:
 			cellVdec.error("cellVdecGetPictureExt: experimental AVPixelFormat (handle=0x%x, seq_id=%d, cmd_id=%d, format=%d). This may cause suboptimal video quality.", handle, frame.seq_id, frame.cmd_id, frame->format);
 			[[fallthrough]];
 		case AV_PIX_FMT_YUV420P:
-			in_f = alpha_plane ? AV_PIX_FMT_YUVA420P : static_cast<AVPixelFormat>(frame->format);
 			break;
 		default:
 			fmt::throw_exception("cellVdecGetPictureExt: Unknown frame format (%d)", frame->format);
 		}
 
-		cellVdec.trace("cellVdecGetPictureExt: handle=0x%x, seq_id=%d, cmd_id=%d, w=%d, h=%d, frameFormat=%d, formatType=%d, in_f=%d, out_f=%d, alpha_plane=%d, alpha=%d, colorMatrixType=%d", handle, frame.seq_id, frame.cmd_id, w, h, frame->format, format->formatType, +in_f, +out_f, !!alpha_plane, format->alpha, format->colorMatrixType);
-
-		vdec->sws = sws_getCachedContext(vdec->sws, w, h, in_f, w, h, out_f, SWS_POINT, nullptr, nullptr, nullptr);
+		const AVPixelFormat in_f = static_cast<AVPixelFormat>(frame->format);
 
-		u8* in_data[4] = { frame->data[0], frame->data[1], frame->data[2], alpha_plane.get() };
-		int in_line[4] = { frame->linesize[0], frame->linesize[1], frame->linesize[2], w * 1 };
-		u8* out_data[4] = { outBuff.get_ptr() };
-		int out_line[4] = { w * 4 }; // RGBA32 or ARGB32
+		cellVdec.trace("cellVdecGetPictureExt: handle=0x%x, seq_id=%d, cmd_id=%d, w=%d, h=%d, frameFormat=%d, formatType=%d, in_f=%d, out_f=%d, alpha=%d, colorMatrixType=%d", handle, frame.seq_id, frame.cmd_id, w, h, frame->format, format->formatType, +in_f, +out_f, format->alpha, format->colorMatrixType);
 
-		if (!alpha_plane)
+		if (rgb32)
+		{
+			// Convert directly into the output buffer
+			const bool bt709 = format->colorMatrixType == CELL_VDEC_COLOR_MATRIX_TYPE_BT709;
+			vdec_yuv420_to_rgb32(frame.avf.get(), outBuff.get_ptr(), format->alpha, out_f == AV_PIX_FMT_ARGB, vdec_yuv_coefs::get(bt709, in_f == AV_PIX_FMT_YUVJ420P));
+		}
+		else
 		{
 			// YUV420P or UYVY422
+			vdec->sws = sws_getCachedContext(vdec->sws, w, h, in_f, w, h, out_f, SWS_POINT, nullptr, nullptr, nullptr);
+
+			u8* out_data[4] = { outBuff.get_ptr() };
+			int out_line[4] = {};
+
 			out_data[1] = out_data[0] + w * h;
 			out_data[2] = out_data[0] + w * h * 5 / 4;
 
@@ -1256,9 +1443,9 @@ error_code cellVdecGetPictureExt(u32 handle, vm::cptr<CellVdecPicFormat2> format
 			{
 				fmt::throw_exception("cellVdecGetPictureExt: av_image_fill_linesizes failed (handle=0x%x, seq_id=%d, cmd_id=%d, ret=0x%x): %s", handle, frame.seq_id, frame.cmd_id, ret, utils::av_error_to_string(ret));
 			}
-		}
 
-		sws_scale(vdec->sws, in_data, in_line, 0, h, out_data, out_line);
+			sws_scale(vdec->sws, frame->data, frame->linesize, 0, h, out_data, out_line);
+		}
 
 		//const u32 buf_size = utils::align(av_image_get_buffer_size(vdec->ctx->pix_fmt, vdec->ctx->width, vdec->ctx->height, 1), 128);
 
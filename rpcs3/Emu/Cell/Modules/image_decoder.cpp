@@ -0,0 +1,238 @@
+#include "stdafx.h"
+#include "image_decoder.h"
+#include "Emu/IdManager.h"
+#include "Utilities/lockless.h"
+#include "util/sysinfo.hpp"
+#include "util/v128.hpp"
+#include "util/simd.hpp"
+
+// STB_IMAGE_IMPLEMENTATION is already defined in stb_image.cpp
+#include <stb_image.h>
+
+#include "xxhash.h"
+
+#include <list>
+#include <unordered_map>
+
+LOG_CHANNEL(img_dec_log, "ImageDec");
+
+namespace
+{
+	struct image_entry
+	{
+		// 0: pending, 1: decoding, 2: done
+		atomic_t<u32> state = 0;
+
+		std::vector<u8> data; // Encoded image (released after decoding)
+		std::shared_ptr<const image_decoder::image> result;
+
+		// Decode if nobody else has started yet, then wait for the result
+		void run()
+		{
+			if (state.compare_and_swap_test(0, 1))
+			{
+				int width = 0, height = 0, components = 0;
+
+				if (const auto pixels = std::unique_ptr<u8, decltype(&::free)>(stbi_load_from_memory(data.data(), ::narrow<int>(data.size()), &width, &height, &components, 4), &::free))
+				{
+					auto img = std::make_shared<image_decoder::image>();
+					img->width = width;
+					img->height = height;
+					img->rgba.assign(pixels.get(), pixels.get() + usz{img->width} * img->height * 4);
+					result = std::move(img);
+				}
+				else
+				{
+					img_dec_log.error("Failed to decode image (size=0x%x): %s", data.size(), stbi_failure_reason());
+				}
+
+				data = {};
+				state.release(2);
+				state.notify_all();
+				return;
+			}
+
+			for (u32 old = state; old != 2; old = state)
+			{
+				state.wait(old);
+			}
+		}
+	};
+
+	struct image_decode_worker
+	{
+		lf_queue<std::shared_ptr<image_entry>> requests;
+
+		void operator()()
+		{
+			while (thread_ctrl::state() != thread_state::aborting)
+			{
+				for (auto&& entry : requests.pop_all())
+				{
+					entry->run();
+				}
+
+				thread_ctrl::wait_on(requests, nullptr);
+			}
+		}
+	};
+
+	struct image_decode_manager
+	{
+		// Decoded images are kept until this amount of memory is used
+		static constexpr usz max_cache_size = 64 * 1024 * 1024;
+
+		shared_mutex mutex;
+
+		std::unique_ptr<named_thread_group<image_decode_worker>> workers;
+		u32 worker_index = 0;
+
+		// Most recently used first
+		std::list<std::pair<u64, std::shared_ptr<image_entry>>> lru;
+		std::unordered_map<u64, decltype(lru)::iterator> entries;
+		usz cache_size = 0;
+
+		// Find or create the entry for the image data, returns true if it is new
+		std::pair<std::shared_ptr<image_entry>, bool> get(std::vector<u8>&& data)
+		{
+			const u64 hash = XXH64(data.data(), data.size(), data.size());
+
+			std::lock_guard lock(mutex);
+
+			if (const auto found = entries.find(hash); found != entries.end())
+			{
+				lru.splice(lru.begin(), lru, found->second);
+				return {found->second->second, false};
+			}
+
+			auto entry = std::make_shared<image_entry>();
+			entry->data = std::move(data);
+
+			lru.emplace_front(hash, entry);
+			entries.emplace(hash, lru.begin());
+
+			evict();
+			return {std::move(entry), true};
+		}
+
+		// Drop the least recently used decoded images
+		void evict()
+		{
+			cache_size = 0;
+
+			for (auto it = lru.begin(); it != lru.end();)
+			{
+				const auto& entry = it->second;
+
+				if (entry->state != 2)
+				{
+					++it;
+					continue;
+				}
+
+				const usz size = entry->result ? entry->result->rgba.size() : 0;
+
+				if (cache_size + size > max_cache_size)
+				{
+					entries.erase(it->first);
+					it = lru.erase(it);
+					continue;
+				}
+
+				cache_size += size;
+				++it;
+			}
+		}
+
+		void push(std::shared_ptr<image_entry> entry)
+		{
+			std::lock_guard lock(mutex);
+
+			if (!workers)
+			{
+				workers = std::make_unique<named_thread_group<image_decode_worker>>("Image Decoder ", std::clamp<u32>(utils::get_thread_count() / 2, 1, 4));
+			}
+
+			(workers->begin() + (worker_index++ % workers->size()))->requests.push(std::move(entry));
+		}
+	};
+}
+
+namespace image_decoder
+{
+	void prefetch(std::vector<u8> data)
+	{
+		auto& m = g_fxo->get<image_decode_manager>();
+
+		if (auto [entry, is_new] = m.get(std::move(data)); is_new)
+		{
+			m.push(std::move(entry));
+		}
+	}
+
+	std::shared_ptr<const image> decode(std::vector<u8> data)
+	{
+		auto& m = g_fxo->get<image_decode_manager>();
+
+		// Decodes on the current thread unless a worker has already started
+		const auto entry = m.get(std::move(data)).first;
+		entry->run();
+
+		return entry->result;
+	}
+
+	void write(const image& img, u8* dst, u32 pitch, output_format format, bool flip)
+	{
+		const u32 width = img.width;
+		const u32 height = img.height;
+		const u32 line_size = width * (format == output_format::rgb ? 3 : 4);
+		const u32 stride = std::max(pitch, line_size);
+
+		for (u32 y = 0; y < height; y++)
+		{
+			const u8* src = img.rgba.data() + usz{flip ? height - y - 1 : y} * width * 4;
+			u8* out = dst + usz{y} * stride;
+
+			switch (format)
+			{
+			case output_format::rgba:
+			{
+				std::memcpy(out, src, line_size);
+				break;
+			}
+			case output_format::argb:
+			{
+				u32 x = 0;
+
+				// Move alpha (A8) to the leftmost byte
+				for (; x + 4 <= width; x += 4)
+				{
+					const v128 v = v128::loadu(src + x * 4);
+					v128::storeu(gv_shl32(v, 8) | gv_shr32(v, 24), out + x * 4);
+				}
+
+				for (; x < width; x++)
+				{
+					out[x * 4 + 0] = src[x * 4 + 3];
+					out[x * 4 + 1] = src[x * 4 + 0];
+					out[x * 4 + 2] = src[x * 4 + 1];
+					out[x * 4 + 3] = src[x * 4 + 2];
+				}
+
+				break;
+			}
+			case output_format::rgb:
+			{
+				for (u32 x = 0; x < width; x++)
+				{
+					out[x * 3 + 0] = src[x * 4 + 0];
+					out[x * 3 + 1] = src[x * 4 + 1];
+					out[x * 3 + 2] = src[x * 4 + 2];
+				}
+
+				break;
+			}
+			}
+		}
+	}
+}
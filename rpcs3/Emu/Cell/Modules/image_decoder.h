@@ -0,0 +1,34 @@
+#pragma once
+
+#include "util/types.hpp"
+
+#include <memory>
+#include <vector>
+
+// Host side image decoding shared by cellJpgDec and cellGifDec.
+// Images are decoded by stb_image on a pool of host threads and cached by content hash.
+namespace image_decoder
+{
+	struct image
+	{
+		u32 width = 0;
+		u32 height = 0;
+		std::vector<u8> rgba; // RGBA8, top to bottom
+	};
+
+	enum class output_format : u32
+	{
+		rgba,
+		argb,
+		rgb,
+	};
+
+	// Start decoding in the background (a later decode() call with the same data picks up the result)
+	void prefetch(std::vector<u8> data);
+
+	// Decode an image or get it from the cache (returns nullptr if the data can't be decoded)
+	std::shared_ptr<const image> decode(std::vector<u8> data);
+
+	// Convert the image into the guest output buffer (pitch is the size of an output line in bytes, 0 if tightly packed)
+	void write(const image& img, u8* dst, u32 pitch, output_format format, bool flip);
+}
@@ -527,13 +527,13 @@ error_code sceNpTrophyRegisterContext(ppu_thread& ppu, u32 context, u32 handle,
 
 	// open trophy pack file
 	std::string trp_path = vfs::get(Emu.GetDir() + "TROPDIR/" + ctxt->trp_name + "/TROPHY.TRP");
-	fs::file stream(trp_path);
+	fs::file stream = fs::make_mapped(trp_path);
 
 	if (!stream && Emu.GetCat() == "GD")
 	{
 		sceNpTrophy.warning("sceNpTrophyRegisterContext failed to open trophy file from boot path: '%s'", trp_path);
 		trp_path = vfs::get("/dev_bdvd/PS3_GAME/TROPDIR/" + ctxt->trp_name + "/TROPHY.TRP");
-		stream.open(trp_path);
+		stream = fs::make_mapped(trp_path);
 	}
 
 	// check if exists and opened
@@ -4,10 +4,13 @@
 #include "PPUOpcodes.h"
 #include "PPUModule.h"
 #include "Emu/system_config.h"
+#include "Crypto/sha1.h"
 
 #include <unordered_set>
 #include "util/yaml.hpp"
 #include "util/asm.hpp"
+#include "util/v128.hpp"
+#include "util/serialization.hpp"
 
 LOG_CHANNEL(ppu_validator);
 
@@ -532,8 +535,210 @@ namespace ppu_patterns
 	};
 }
 
+// Analysis cache version, part of the cache key
+// Must be bumped on every change to ppu_module::analyse (or anything it calls) that can change its results, like the PPU LLVM object version tag
+constexpr u32 c_ppu_analysis_cache_version = 2;
+
+// Get analysis cache file path, keyed by the analysed memory contents and analyser inputs (empty if not cacheable)
+static std::string ppu_get_analysis_cache_path(const ppu_module& info, u32 lib_toc, u32 entry, u32 sec_end, const std::basic_string<u32>& applied)
+{
+	sha1_context ctx;
+	sha1_starts(&ctx);
+
+	const u32 params[]{c_ppu_analysis_cache_version, lib_toc, entry, sec_end};
+	sha1_update(&ctx, reinterpret_cast<const u8*>(params), sizeof(params));
+
+	for (const auto& seg : info.segs)
+	{
+		if (seg.size && !vm::check_addr(seg.addr, vm::page_readable, seg.size))
+		{
+			return {};
+		}
+
+		sha1_update(&ctx, reinterpret_cast<const u8*>(&seg), sizeof(seg));
+		sha1_update(&ctx, vm::_ptr<u8>(seg.addr), seg.size);
+	}
+
+	for (const auto& sec : info.secs)
+	{
+		sha1_update(&ctx, reinterpret_cast<const u8*>(&sec), sizeof(sec));
+	}
+
+	for (const auto& rel : info.relocs)
+	{
+		sha1_update(&ctx, reinterpret_cast<const u8*>(&rel), sizeof(rel));
+	}
+
+	sha1_update(&ctx, reinterpret_cast<const u8*>(applied.data()), applied.size() * sizeof(u32));
+
+	u8 output[20];
+	sha1_finish(&ctx, output);
+
+	return fmt::format("%scache/ppu-analysis/%s.dat", fs::get_cache_dir(), fmt::base57(output));
+}
+
+// Analysis cache file header, followed by the serialized payload
+struct ppu_analysis_cache_header
+{
+	le_t<u32> magic;
+	le_t<u32> version;
+	le_t<u32> layout;
+	le_t<u32> pad;
+	le_t<u64> size; // Payload size
+	u8 checksum[20]; // SHA-1 of the payload
+};
+
+// Serialized layout signature: number of attributes and fields stored per function
+constexpr u32 c_ppu_analysis_cache_layout = static_cast<u32>(ppu_attr::__bitset_enum_max) << 16 | 10;
+
+// Smallest possible serialized ppu_function (6 x u32 followed by a name and 3 vectors of at least 1 byte each)
+constexpr usz c_ppu_analysis_cache_min_func = sizeof(u32) * 6 + 4;
+
+static void ppu_analysis_cache_checksum(const std::vector<u8>& data, usz offset, u8 (&output)[20])
+{
+	sha1_context ctx;
+	sha1_starts(&ctx);
+	sha1_update(&ctx, data.data() + offset, data.size() - offset);
+	sha1_finish(&ctx, output);
+}
+
+static bool ppu_load_analysis_cache(const std::string& path, std::vector<ppu_function>& funcs)
+{
+	fs::file file(path);
+
+	if (!file)
+	{
+		return false;
+	}
+
+	std::vector<u8> data = file.to_vector<u8>();
+	file.close();
+
+	const auto discard = [&](std::string_view reason)
+	{
+		ppu_log.error("Ignoring damaged PPU analysis cache (%s): %s", reason, path);
+		fs::remove_file(path);
+		return false;
+	};
+
+	ppu_analysis_cache_header header{};
+
+	if (data.size() < sizeof(header))
+	{
+		return discard("truncated");
+	}
+
+	std::memcpy(&header, data.data(), sizeof(header));
+
+	if (header.magic != "PPUA"_u32 || header.version != c_ppu_analysis_cache_version || header.layout != c_ppu_analysis_cache_layout)
+	{
+		return discard("version mismatch");
+	}
+
+	if (header.size != data.size() - sizeof(header))
+	{
+		return discard("size mismatch");
+	}
+
+	u8 checksum[20];
+	ppu_analysis_cache_checksum(data, sizeof(header), checksum);
+
+	if (std::memcmp(checksum, header.checksum, sizeof(checksum)) != 0)
+	{
+		return discard("checksum mismatch");
+	}
+
+	data.erase(data.begin(), data.begin() + sizeof(header));
+
+	const usz payload_size = data.size();
+
+	utils::serial ar;
+	ar.set_reading_state(std::move(data));
+
+	usz count = 0;
+	ar.deserialize_vle(count);
+
+	if (count > payload_size / c_ppu_analysis_cache_min_func)
+	{
+		return discard("invalid function count");
+	}
+
+	std::vector<ppu_function> result(count);
+
+	for (ppu_function& func : result)
+	{
+		const u32 attr = ar;
+		func.attr = std::bit_cast<bs_t<ppu_attr>>(attr);
+		ar(func.addr, func.toc, func.size, func.stack_frame, func.trampoline, func.name);
+
+		const std::vector<u32> blocks = ar;
+		const std::vector<u32> calls = ar;
+		const std::vector<u32> callers = ar;
+
+		for (usz i = 0; i + 1 < blocks.size(); i += 2)
+		{
+			func.blocks.emplace_hint(func.blocks.end(), blocks[i], blocks[i + 1]);
+		}
+
+		func.calls.insert(calls.begin(), calls.end());
+		func.callers.insert(callers.begin(), callers.end());
+	}
+
+	if (ar.pos != payload_size)
+	{
+		return discard("trailing data");
+	}
+
+	funcs = std::move(result);
+	return true;
+}
+
+static void ppu_save_analysis_cache(const std::string& path, const std::vector<ppu_function>& funcs)
+{
+	utils::serial ar;
+	ar.serialize_vle(funcs.size());
+
+	std::vector<u32> blocks, calls, callers;
+
+	for (const ppu_function& func : funcs)
+	{
+		blocks.clear();
+
+		for (const auto& [addr, size] : func.blocks)
+		{
+			blocks.push_back(addr);
+			blocks.push_back(size);
+		}
+
+		calls.assign(func.calls.begin(), func.calls.end());
+		callers.assign(func.callers.begin(), func.callers.end());
+
+		ar(static_cast<u32>(func.attr), func.addr, func.toc, func.size, func.stack_frame, func.trampoline, func.name, blocks, calls, callers);
+	}
+
+	ppu_analysis_cache_header header{};
+	header.magic = "PPUA"_u32;
+	header.version = c_ppu_analysis_cache_version;
+	header.layout = c_ppu_analysis_cache_layout;
+	header.size = ar.data.size();
+	ppu_analysis_cache_checksum(ar.data, 0, header.checksum);
+
+	if (!fs::create_path(fs::get_parent_dir(path)) || !fs::write_file(path, fs::rewrite, header, ar.data))
+	{
+		ppu_log.error("Failed to write PPU analysis cache: %s (%s)", path, fs::g_tls_error);
+	}
+}
+
 void ppu_module::analyse(u32 lib_toc, u32 entry, const u32 sec_end, const std::basic_string<u32>& applied)
 {
+	const std::string cache_path = g_cfg.core.ppu_analysis_cache ? ppu_get_analysis_cache_path(*this, lib_toc, entry, sec_end, applied) : std::string{};
+
+	if (!cache_path.empty() && funcs.empty() && ppu_load_analysis_cache(cache_path, funcs))
+	{
+		ppu_log.notice("Block analysis: %zu blocks (loaded from cache)", funcs.size());
+		return;
+	}
+
 	// Assume first segment is executable
 	const u32 start = segs[0].addr;
 
@@ -1865,6 +2070,11 @@ void ppu_module::analyse(u32 lib_toc, u32 entry, const u32 sec_end, const std::b
 	}
 
 	ppu_log.notice("Block analysis: %zu blocks (%zu enqueued)", funcs.size(), block_queue.size());
+
+	if (!cache_path.empty())
+	{
+		ppu_save_analysis_cache(cache_path, funcs);
+	}
 }
 
 // Temporarily
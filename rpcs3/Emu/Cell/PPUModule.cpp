@@ -1678,7 +1678,7 @@ bool ppu_load_exec(const ppu_exec_object& elf)
 	{
 		for (const auto& name : load_libs)
 		{
-			const ppu_prx_object obj = decrypt_self(fs::file(lle_dir + name));
+			const ppu_prx_object obj = decrypt_self(fs::make_mapped(lle_dir + name));
 
 			if (obj == elf_error::ok)
 			{
@@ -2567,7 +2567,7 @@ extern void ppu_precompile(std::vector<std::string>& dir_queue, std::vector<lv2_
 			ppu_log.notice("Trying to load: %s", path);
 
 			// Load MSELF, SPRX or SELF
-			fs::file src{path};
+			fs::file src = fs::make_mapped(path);
 
 			if (!src)
 			{
@@ -3218,9 +3218,44 @@ bool ppu_initialize(const ppu_module& info, bool check_only)
 			atomic_t<u64> index = 0;
 		};
 
+		// Start with the largest parts so that the last worker doesn't end up compiling a huge one alone
+		{
+			std::vector<std::pair<u64, usz>> order;
+			order.reserve(workload.size());
+
+			for (usz i = 0; i < workload.size(); i++)
+			{
+				u64 size = 0;
+
+				for (const auto& func : workload[i].second.funcs)
+				{
+					size += func.size;
+				}
+
+				order.emplace_back(size, i);
+			}
+
+			std::stable_sort(order.begin(), order.end(), [](const auto& a, const auto& b)
+			{
+				return a.first > b.first;
+			});
+
+			std::vector<std::pair<std::string, ppu_module>> sorted;
+			sorted.reserve(workload.size());
+
+			for (const auto& [size, index] : order)
+			{
+				sorted.emplace_back(std::move(workload[index]));
+			}
+
+			workload = std::move(sorted);
+		}
+
 		// Prevent watchdog thread from terminating
 		g_watchdog_hold_ctr++;
 
+		const u64 compile_start = get_system_time();
+
 		named_thread_group threads(fmt::format("PPUW.%u.", ++g_fxo->get<thread_index_allocator>().index), thread_count, [&]()
 		{
 			// Set low priority
@@ -3241,11 +3276,13 @@ bool ppu_initialize(const ppu_module& info, bool check_only)
 
 				ppu_log.warning("LLVM: Compiling module %s%s", cache_path, obj_name);
 
+				const u64 start = get_system_time();
+
 				// Use another JIT instance
 				jit_compiler jit2({}, g_cfg.core.llvm_cpu, 0x1);
 				ppu_initialize2(jit2, part, cache_path, obj_name);
 
-				ppu_log.success("LLVM: Compiled module %s", obj_name);
+				ppu_log.success("LLVM: Compiled module %s (%.3fs)", obj_name, (get_system_time() - start) / 1000000.);
 			}
 		});
 
@@ -3253,6 +3290,11 @@ bool ppu_initialize(const ppu_module& info, bool check_only)
 
 		g_watchdog_hold_ctr--;
 
+		if (!workload.empty())
+		{
+			ppu_log.notice("LLVM: Compiled %u module(s) of %s in %.3fs using %u thread(s)", workload.size(), info.name, (get_system_time() - compile_start) / 1000000., thread_count);
+		}
+
 		if (Emu.IsStopped() || !get_current_cpu_thread())
 		{
 			return compiled_new;
@@ -3264,14 +3306,56 @@ bool ppu_initialize(const ppu_module& info, bool check_only)
 			g_progr = "Linking PPU modules...";
 		}
 
-		for (auto [obj_name, is_compiled] : link_workload)
+		// Decompress object files in parallel and link them in order while the following ones are still loading
+		const u32 load_threads = std::max<u32>(std::min<u32>(rpcs3::utils::get_max_threads(), ::size32(link_workload)), 1);
+
+		// Loaders may only run this far ahead of the linker to limit memory usage
+		const u32 load_window = load_threads * 2;
+
+		std::vector<std::unique_ptr<llvm::MemoryBuffer>> objects(link_workload.size());
+		std::unique_ptr<atomic_t<u32>[]> loaded = std::make_unique<atomic_t<u32>[]>(link_workload.size());
+
+		atomic_t<u32> load_index = 0;
+		atomic_t<u32> linked = 0;
+
+		named_thread_group loaders("PPU Object Loader ", load_threads, [&]()
+		{
+			for (u32 i = load_index++; i < link_workload.size(); i = load_index++)
+			{
+				// Wait for the linker to consume earlier objects
+				for (u32 done = linked; done != umax && i >= done + load_window; done = linked)
+				{
+					linked.wait(done);
+				}
+
+				if (!Emu.IsStopped() && linked != umax)
+				{
+					objects[i] = jit_compiler::load(cache_path + link_workload[i].first);
+				}
+
+				loaded[i].release(1);
+				loaded[i].notify_one();
+			}
+		});
+
+		for (usz i = 0; i < link_workload.size(); i++)
 		{
+			const auto& [obj_name, is_compiled] = link_workload[i];
+
+			while (!loaded[i])
+			{
+				loaded[i].wait(0);
+			}
+
 			if (Emu.IsStopped())
 			{
 				break;
 			}
 
-			jit->add(cache_path + obj_name);
+			jit->add(std::move(objects[i]), cache_path + obj_name);
+
+			linked++;
+			linked.notify_all();
 
 			if (!is_compiled)
 			{
@@ -3279,6 +3363,11 @@ bool ppu_initialize(const ppu_module& info, bool check_only)
 				g_progr_pdone++;
 			}
 		}
+
+		// Release the loaders if linking was interrupted
+		linked = umax;
+		linked.notify_all();
+		loaders.join();
 	}
 
 	if (Emu.IsStopped() || !get_current_cpu_thread())
@@ -271,6 +271,9 @@ public:
 
 	u64 saved_native_sp = 0; // Host thread's stack pointer for emulated longjmp
 
+	u32 spu_affinity_group = 0; // SPU thread group which pinned this thread to its cache domain (0 = not pinned)
+	u64 spu_affinity_restore = 0; // Host affinity mask to restore once that group stops
+
 	u64 last_ftsc = 0;
 	u64 last_ftime = 0;
 	u32 last_faddr = 0;
@@ -177,7 +177,7 @@ spu_function_t spu_recompiler::compile(spu_program&& _func)
 	// Create block labels
 	for (u32 i = 0; i < func.data.size(); i++)
 	{
-		if (func.data[i] && m_block_info[i + start / 4])
+		if (func.data[i] && m_analysis->block_info[i + start / 4])
 		{
 			instr_labels[i * 4 + start] = c->newLabel();
 		}
@@ -797,7 +797,7 @@ spu_function_t spu_recompiler::compile(spu_program&& _func)
 
 		if (found != instr_labels.end())
 		{
-			if (m_preds.count(pos))
+			if (m_analysis->preds.count(pos))
 			{
 				c->align(AlignMode::kCode, 16);
 			}
@@ -2512,7 +2512,7 @@ void spu_recompiler::BIZ(spu_opcode_t op)
 	c->cmp(SPU_OFF_32(gpr, op.rt, &v128::_u32, 3), 0);
 	c->je(branch_label);
 
-	after.emplace_back([=, this, jt = m_targets[m_pos].size() > 1]
+	after.emplace_back([=, this, jt = m_analysis->targets[m_pos].size() > 1]
 	{
 		c->align(asmjit::AlignMode::kCode, 16);
 		c->bind(branch_label);
@@ -2528,7 +2528,7 @@ void spu_recompiler::BINZ(spu_opcode_t op)
 	c->cmp(SPU_OFF_32(gpr, op.rt, &v128::_u32, 3), 0);
 	c->jne(branch_label);
 
-	after.emplace_back([=, this, jt = m_targets[m_pos].size() > 1]
+	after.emplace_back([=, this, jt = m_analysis->targets[m_pos].size() > 1]
 	{
 		c->align(asmjit::AlignMode::kCode, 16);
 		c->bind(branch_label);
@@ -2544,7 +2544,7 @@ void spu_recompiler::BIHZ(spu_opcode_t op)
 	c->cmp(SPU_OFF_16(gpr, op.rt, &v128::_u16, 6), 0);
 	c->je(branch_label);
 
-	after.emplace_back([=, this, jt = m_targets[m_pos].size() > 1]
+	after.emplace_back([=, this, jt = m_analysis->targets[m_pos].size() > 1]
 	{
 		c->align(asmjit::AlignMode::kCode, 16);
 		c->bind(branch_label);
@@ -2560,7 +2560,7 @@ void spu_recompiler::BIHNZ(spu_opcode_t op)
 	c->cmp(SPU_OFF_16(gpr, op.rt, &v128::_u16, 6), 0);
 	c->jne(branch_label);
 
-	after.emplace_back([=, this, jt = m_targets[m_pos].size() > 1]
+	after.emplace_back([=, this, jt = m_analysis->targets[m_pos].size() > 1]
 	{
 		c->align(asmjit::AlignMode::kCode, 16);
 		c->bind(branch_label);
@@ -2600,10 +2600,10 @@ void spu_recompiler::STQX(spu_opcode_t op)
 
 void spu_recompiler::BI(spu_opcode_t op)
 {
-	const auto found = m_targets.find(m_pos);
-	const auto is_jt = found == m_targets.end() || found->second.size() > 1;
+	const auto found = m_analysis->targets.find(m_pos);
+	const auto is_jt = found == m_analysis->targets.end() || found->second.size() > 1;
 
-	if (found == m_targets.end())
+	if (found == m_analysis->targets.end())
 	{
 		spu_log.error("[0x%x] BI: no targets", m_pos);
 	}
@@ -19,6 +19,7 @@
 #include "SPUDisAsm.h"
 #include <algorithm>
 #include <mutex>
+#include <condition_variable>
 #include <thread>
 #include <optional>
 #include <unordered_set>
@@ -437,40 +438,41 @@ void spu_cache::initialize()
 		worker_count = rpcs3::utils::get_max_threads();
 	}
 
-	named_thread_group workers("SPU Worker ", worker_count, [&]() -> uint
+	// Program analysed ahead of compilation (no state if skipped)
+	struct analysed_program
 	{
-		// Set low priority
-		thread_ctrl::scoped_priority low_prio(-1);
+		std::unique_ptr<spu_recompiler_base> state;
+		spu_program func;
+	};
 
-		// Initialize compiler instances for parallel compilation
-		std::unique_ptr<spu_recompiler_base> compiler;
+	std::mutex analysed_mutex;
+	std::condition_variable analysed_cv;
+	std::condition_variable free_cv;
+	std::deque<analysed_program> analysed;
+	std::vector<std::unique_ptr<spu_recompiler_base>> free_states;
+	atomic_t<usz> fdone{};
 
-		if (g_cfg.core.spu_decoder == spu_decoder_type::asmjit)
-		{
-			compiler = spu_recompiler_base::make_asmjit_recompiler();
-		}
-		else if (g_cfg.core.spu_decoder == spu_decoder_type::llvm)
-		{
-			compiler = spu_recompiler_base::make_llvm_recompiler();
-		}
+	// Analysis is much cheaper than compilation, only a few threads are needed to stay ahead
+	const u32 analyser_count = worker_count ? std::max<u32>(worker_count / 4, 1) : 0;
 
-		compiler->init();
+	for (u32 i = 0; i < worker_count + analyser_count; i++)
+	{
+		free_states.emplace_back(spu_recompiler_base::make_analyser());
+	}
 
-		// How much every thread compiled
-		uint result = 0;
+	named_thread_group analysers("SPU Analyser ", analyser_count, [&]()
+	{
+		// Set low priority
+		thread_ctrl::scoped_priority low_prio(-1);
 
 		// Fake LS
 		std::vector<be_t<u32>> ls(0x10000);
 
-		// Build functions
-		for (usz func_i = fnext++; func_i < func_list.size(); func_i = fnext++, g_progr_pdone++)
+		for (usz func_i = fnext++; func_i < func_list.size(); func_i = fnext++)
 		{
 			const spu_program& func = std::as_const(func_list)[func_i];
 
-			if (Emu.IsStopped() || fail_flag)
-			{
-				continue;
-			}
+			analysed_program item{};
 
 			// Get data start
 			const u32 start = func.lower_bound;
@@ -490,35 +492,118 @@ void spu_cache::initialize()
 			// Check hash against allowed bounds
 			const bool inverse_bounds = g_cfg.core.spu_llvm_lower_bound > g_cfg.core.spu_llvm_upper_bound;
 
-			if ((!inverse_bounds && (hash_start < g_cfg.core.spu_llvm_lower_bound || hash_start > g_cfg.core.spu_llvm_upper_bound)) ||
+			if (Emu.IsStopped() || fail_flag)
+			{
+				// Pass an empty item to the workers
+			}
+			else if ((!inverse_bounds && (hash_start < g_cfg.core.spu_llvm_lower_bound || hash_start > g_cfg.core.spu_llvm_upper_bound)) ||
 				(inverse_bounds && (hash_start < g_cfg.core.spu_llvm_lower_bound && hash_start > g_cfg.core.spu_llvm_upper_bound)))
 			{
 				spu_log.error("[Debug] Skipped function %s", fmt::base57(hash_start));
-				result++;
-				continue;
+			}
+			else
+			{
+				{
+					std::unique_lock lock(analysed_mutex);
+					free_cv.wait(lock, [&] { return !free_states.empty(); });
+					item.state = std::move(free_states.back());
+					free_states.pop_back();
+				}
+
+				// Initialize LS with function data only
+				for (u32 i = 0, pos = start; i < size0; i++, pos += 4)
+				{
+					ls[pos / 4] = std::bit_cast<be_t<u32>>(func.data[i]);
+				}
+
+				// Call analyser
+				item.func = item.state->analyse(ls.data(), func.entry_point);
+
+				if (item.func != func)
+				{
+					spu_log.error("[0x%05x] SPU Analyser failed, %u vs %u", item.func.entry_point, item.func.data.size(), size0);
+
+					{
+						std::lock_guard lock(analysed_mutex);
+						free_states.emplace_back(std::move(item.state));
+					}
+
+					free_cv.notify_one();
+				}
+
+				// Clear fake LS
+				std::memset(ls.data() + start / 4, 0, 4 * (size0 - 1));
 			}
 
-			// Initialize LS with function data only
-			for (u32 i = 0, pos = start; i < size0; i++, pos += 4)
 			{
-				ls[pos / 4] = std::bit_cast<be_t<u32>>(func.data[i]);
+				std::lock_guard lock(analysed_mutex);
+				analysed.emplace_back(std::move(item));
 			}
 
-			// Call analyser
-			spu_program func2 = compiler->analyse(ls.data(), func.entry_point);
+			analysed_cv.notify_one();
+		}
+	});
 
-			if (func2 != func)
+	named_thread_group workers("SPU Worker ", worker_count, [&]() -> uint
+	{
+		// Set low priority
+		thread_ctrl::scoped_priority low_prio(-1);
+
+		// Initialize compiler instances for parallel compilation
+		std::unique_ptr<spu_recompiler_base> compiler;
+
+		if (g_cfg.core.spu_decoder == spu_decoder_type::asmjit)
+		{
+			compiler = spu_recompiler_base::make_asmjit_recompiler();
+		}
+		else if (g_cfg.core.spu_decoder == spu_decoder_type::llvm)
+		{
+			compiler = spu_recompiler_base::make_llvm_recompiler();
+		}
+
+		compiler->init();
+
+		// How much every thread compiled
+		uint result = 0;
+
+		// Build functions (in order of analysis)
+		for (usz func_i = fdone++; func_i < func_list.size(); func_i = fdone++, g_progr_pdone++)
+		{
+			analysed_program item;
 			{
-				spu_log.error("[0x%05x] SPU Analyser failed, %u vs %u", func2.entry_point, func2.data.size(), size0);
+				std::unique_lock lock(analysed_mutex);
+				analysed_cv.wait(lock, [&] { return !analysed.empty(); });
+				item = std::move(analysed.front());
+				analysed.pop_front();
 			}
-			else if (!compiler->compile(std::move(func2)))
+
+			if (item.state)
 			{
-				// Likely, out of JIT memory. Signal to prevent further building.
-				fail_flag |= 1;
-			}
+				// Take analysis results and return the previous state
+				compiler->swap_analysis(*item.state);
 
-			// Clear fake LS
-			std::memset(ls.data() + start / 4, 0, 4 * (size0 - 1));
+				{
+					std::lock_guard lock(analysed_mutex);
+					free_states.emplace_back(std::move(item.state));
+				}
+
+				free_cv.notify_one();
+
+				if (Emu.IsStopped() || fail_flag)
+				{
+					continue;
+				}
+
+				if (!compiler->compile(std::move(item.func)))
+				{
+					// Likely, out of JIT memory. Signal to prevent further building.
+					fail_flag |= 1;
+				}
+			}
+			else if (Emu.IsStopped() || fail_flag)
+			{
+				continue;
+			}
 
 			result++;
 		}
@@ -1173,6 +1258,7 @@ spu_function_t spu_runtime::make_branch_patchpoint(u16 data) const
 }
 
 spu_recompiler_base::spu_recompiler_base()
+	: m_analysis(std::make_unique<analysis_state>())
 {
 }
 
@@ -1330,26 +1416,41 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 	result.lower_bound = entry_point;
 
 	// Initialize block entries
-	m_block_info.reset();
-	m_block_info.set(entry_point / 4);
-	m_entry_info.reset();
-	m_entry_info.set(entry_point / 4);
-	m_ret_info.reset();
+	m_analysis->block_info.reset();
+	m_analysis->block_info.set(entry_point / 4);
+	m_analysis->entry_info.reset();
+	m_analysis->entry_info.set(entry_point / 4);
+	m_analysis->ret_info.reset();
 
 	// Simple block entry workload list
 	workload.clear();
 	workload.push_back(entry_point);
 
-	std::memset(m_regmod.data(), 0xff, sizeof(m_regmod));
-	std::memset(m_use_ra.data(), 0xff, sizeof(m_use_ra));
-	std::memset(m_use_rb.data(), 0xff, sizeof(m_use_rb));
-	std::memset(m_use_rc.data(), 0xff, sizeof(m_use_rc));
-	m_targets.clear();
-	m_preds.clear();
-	m_preds[entry_point];
-	m_bbs.clear();
-	m_chunks.clear();
-	m_funcs.clear();
+	// Only reset the register access info touched by the previous analysis
+	if (m_analysis->dirty_begin < m_analysis->dirty_end)
+	{
+		const u32 count = m_analysis->dirty_end - m_analysis->dirty_begin;
+		std::memset(m_analysis->regmod.data() + m_analysis->dirty_begin, 0xff, count);
+		std::memset(m_analysis->use_ra.data() + m_analysis->dirty_begin, 0xff, count);
+		std::memset(m_analysis->use_rb.data() + m_analysis->dirty_begin, 0xff, count);
+		std::memset(m_analysis->use_rc.data() + m_analysis->dirty_begin, 0xff, count);
+	}
+
+	m_analysis->dirty_begin = 0x10000;
+	m_analysis->dirty_end = 0;
+
+	m_analysis->targets.clear();
+	m_analysis->preds.clear();
+	m_analysis->preds[entry_point];
+
+	// Keep the block nodes for reuse
+	while (!m_analysis->bbs.empty())
+	{
+		m_analysis->bb_pool.emplace_back(m_analysis->bbs.extract(m_analysis->bbs.begin()));
+	}
+
+	m_analysis->chunks.clear();
+	m_analysis->funcs.clear();
 
 	// Value flags (TODO: only is_const is implemented)
 	enum class vf : u32
@@ -1406,16 +1507,16 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 			if (target >= lsa && target < limit)
 			{
 				// Check for redundancy
-				if (!m_block_info[target / 4])
+				if (!m_analysis->block_info[target / 4])
 				{
-					m_block_info[target / 4] = true;
+					m_analysis->block_info[target / 4] = true;
 					workload.push_back(target);
 				}
 
 				// Add predecessor
-				if (m_preds[target].find_first_of(pos) + 1 == 0)
+				if (m_analysis->preds[target].find_first_of(pos) + 1 == 0)
 				{
-					m_preds[target].push_back(pos);
+					m_analysis->preds[target].push_back(pos);
 				}
 			}
 		};
@@ -1432,17 +1533,20 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 
 		wa += 4;
 
-		m_targets.erase(pos);
+		m_analysis->dirty_begin = std::min(m_analysis->dirty_begin, pos / 4);
+		m_analysis->dirty_end = std::max(m_analysis->dirty_end, pos / 4 + 1);
+
+		m_analysis->targets.erase(pos);
 
 		// Fill register access info
 		if (auto iflags = g_spu_iflag.decode(data))
 		{
 			if (+iflags & +spu_iflag::use_ra)
-				m_use_ra[pos / 4] = op.ra;
+				m_analysis->use_ra[pos / 4] = op.ra;
 			if (+iflags & +spu_iflag::use_rb)
-				m_use_rb[pos / 4] = op.rb;
+				m_analysis->use_rb[pos / 4] = op.rb;
 			if (+iflags & +spu_iflag::use_rc)
-				m_use_rc[pos / 4] = op.rc;
+				m_analysis->use_rc[pos / 4] = op.rc;
 		}
 
 		// Analyse instruction
@@ -1474,7 +1578,7 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 			if (g_cfg.core.spu_block_size == spu_block_size_type::safe)
 			{
 				// Stop on special instructions (TODO)
-				m_targets[pos];
+				m_analysis->targets[pos];
 				next_block();
 				break;
 			}
@@ -1495,7 +1599,7 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 				spu_log.error("[0x%x] Invalid interrupt flags (DE)", pos);
 			}
 
-			m_targets[pos];
+			m_analysis->targets[pos];
 			next_block();
 			break;
 		}
@@ -1519,7 +1623,7 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 
 			if (sl)
 			{
-				m_regmod[pos / 4] = op.rt;
+				m_analysis->regmod[pos / 4] = op.rt;
 				vflags[op.rt] = +vf::is_const;
 				values[op.rt] = pos + 4;
 			}
@@ -1530,7 +1634,7 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 
 				spu_log.warning("[0x%x] At 0x%x: indirect branch to 0x%x%s", entry_point, pos, target, op.d ? " (D)" : op.e ? " (E)" : "");
 
-				m_targets[pos].push_back(target);
+				m_analysis->targets[pos].push_back(target);
 
 				if (g_cfg.core.spu_block_size == spu_block_size_type::giga)
 				{
@@ -1545,7 +1649,7 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 					}
 					else
 					{
-						m_entry_info[target / 4] = true;
+						m_analysis->entry_info[target / 4] = true;
 						add_block(target);
 					}
 				}
@@ -1556,9 +1660,9 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 
 				if (sl && g_cfg.core.spu_block_size != spu_block_size_type::safe)
 				{
-					m_ret_info[pos / 4 + 1] = true;
-					m_entry_info[pos / 4 + 1] = true;
-					m_targets[pos].push_back(pos + 4);
+					m_analysis->ret_info[pos / 4 + 1] = true;
+					m_analysis->entry_info[pos / 4 + 1] = true;
+					m_analysis->targets[pos].push_back(pos + 4);
 					add_block(pos + 4);
 				}
 			}
@@ -1644,10 +1748,10 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 						{
 							add_block(jt_abs[i]);
 							result.data[(start - lsa) / 4 + i] = std::bit_cast<u32, be_t<u32>>(jt_abs[i]);
-							m_targets[start + i * 4];
+							m_analysis->targets[start + i * 4];
 						}
 
-						m_targets.emplace(pos, std::move(jt_abs));
+						m_analysis->targets.emplace(pos, std::move(jt_abs));
 					}
 
 					if (jt_rel.size() >= jt_abs.size())
@@ -1663,10 +1767,10 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 						{
 							add_block(jt_rel[i]);
 							result.data[(start - lsa) / 4 + i] = std::bit_cast<u32, be_t<u32>>(jt_rel[i] - start);
-							m_targets[start + i * 4];
+							m_analysis->targets[start + i * 4];
 						}
 
-						m_targets.emplace(pos, std::move(jt_rel));
+						m_analysis->targets.emplace(pos, std::move(jt_rel));
 					}
 				}
 				else if (start + 12 * 4 < limit &&
@@ -1686,7 +1790,7 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 					// Add 8 targets (TODO)
 					for (u32 addr = start + 4; addr < start + 36; addr += 4)
 					{
-						m_targets[pos].push_back(addr);
+						m_analysis->targets[pos].push_back(addr);
 						add_block(addr);
 					}
 				}
@@ -1704,19 +1808,19 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 			{
 				if (type == spu_itype::BI || g_cfg.core.spu_block_size == spu_block_size_type::safe)
 				{
-					m_targets[pos];
+					m_analysis->targets[pos];
 				}
 				else
 				{
-					m_ret_info[pos / 4 + 1] = true;
-					m_entry_info[pos / 4 + 1] = true;
-					m_targets[pos].push_back(pos + 4);
+					m_analysis->ret_info[pos / 4 + 1] = true;
+					m_analysis->entry_info[pos / 4 + 1] = true;
+					m_analysis->targets[pos].push_back(pos + 4);
 					add_block(pos + 4);
 				}
 			}
 			else
 			{
-				m_targets[pos].push_back(pos + 4);
+				m_analysis->targets[pos].push_back(pos + 4);
 				add_block(pos + 4);
 			}
 
@@ -1729,7 +1833,7 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 		{
 			const u32 target = spu_branch_target(type == spu_itype::BRASL ? 0 : pos, op.i16);
 
-			m_regmod[pos / 4] = op.rt;
+			m_analysis->regmod[pos / 4] = op.rt;
 			vflags[op.rt] = +vf::is_const;
 			values[op.rt] = pos + 4;
 
@@ -1739,19 +1843,19 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 				break;
 			}
 
-			m_targets[pos].push_back(target);
+			m_analysis->targets[pos].push_back(target);
 
 			if (g_cfg.core.spu_block_size != spu_block_size_type::safe)
 			{
-				m_ret_info[pos / 4 + 1] = true;
-				m_entry_info[pos / 4 + 1] = true;
-				m_targets[pos].push_back(pos + 4);
+				m_analysis->ret_info[pos / 4 + 1] = true;
+				m_analysis->entry_info[pos / 4 + 1] = true;
+				m_analysis->targets[pos].push_back(pos + 4);
 				add_block(pos + 4);
 			}
 
 			if (g_cfg.core.spu_block_size == spu_block_size_type::giga && !sync)
 			{
-				m_entry_info[target / 4] = true;
+				m_analysis->entry_info[target / 4] = true;
 				add_block(target);
 			}
 			else
@@ -1777,7 +1881,7 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 
 			if (g_cfg.core.spu_block_size == spu_block_size_type::giga && !sync)
 			{
-				m_entry_info[target / 4] = true;
+				m_analysis->entry_info[target / 4] = true;
 				add_block(target);
 			}
 			else
@@ -1811,12 +1915,12 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 				break;
 			}
 
-			m_targets[pos].push_back(target);
+			m_analysis->targets[pos].push_back(target);
 			add_block(target);
 
 			if (type != spu_itype::BR)
 			{
-				m_targets[pos].push_back(pos + 4);
+				m_analysis->targets[pos].push_back(pos + 4);
 				add_block(pos + 4);
 			}
 
@@ -1850,27 +1954,27 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 			{
 			case MFC_EAL:
 			{
-				m_regmod[pos / 4] = s_reg_mfc_eal;
+				m_analysis->regmod[pos / 4] = s_reg_mfc_eal;
 				break;
 			}
 			case MFC_LSA:
 			{
-				m_regmod[pos / 4] = s_reg_mfc_lsa;
+				m_analysis->regmod[pos / 4] = s_reg_mfc_lsa;
 				break;
 			}
 			case MFC_TagID:
 			{
-				m_regmod[pos / 4] = s_reg_mfc_tag;
+				m_analysis->regmod[pos / 4] = s_reg_mfc_tag;
 				break;
 			}
 			case MFC_Size:
 			{
-				m_regmod[pos / 4] = s_reg_mfc_size;
+				m_analysis->regmod[pos / 4] = s_reg_mfc_size;
 				break;
 			}
 			case MFC_Cmd:
 			{
-				m_use_rb[pos / 4] = s_reg_mfc_eal;
+				m_analysis->use_rb[pos / 4] = s_reg_mfc_eal;
 				break;
 			}
 			default: break;
@@ -1885,7 +1989,7 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 		case spu_itype::LQX:
 		{
 			// Unconst
-			m_regmod[pos / 4] = op.rt;
+			m_analysis->regmod[pos / 4] = op.rt;
 			vflags[op.rt] = {};
 			break;
 		}
@@ -1913,97 +2017,97 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 
 		case spu_itype::IL:
 		{
-			m_regmod[pos / 4] = op.rt;
+			m_analysis->regmod[pos / 4] = op.rt;
 			vflags[op.rt] = +vf::is_const;
 			values[op.rt] = op.si16;
 			break;
 		}
 		case spu_itype::ILA:
 		{
-			m_regmod[pos / 4] = op.rt;
+			m_analysis->regmod[pos / 4] = op.rt;
 			vflags[op.rt] = +vf::is_const;
 			values[op.rt] = op.i18;
 			break;
 		}
 		case spu_itype::ILH:
 		{
-			m_regmod[pos / 4] = op.rt;
+			m_analysis->regmod[pos / 4] = op.rt;
 			vflags[op.rt] = +vf::is_const;
 			values[op.rt] = op.i16 << 16 | op.i16;
 			break;
 		}
 		case spu_itype::ILHU:
 		{
-			m_regmod[pos / 4] = op.rt;
+			m_analysis->regmod[pos / 4] = op.rt;
 			vflags[op.rt] = +vf::is_const;
 			values[op.rt] = op.i16 << 16;
 			break;
 		}
 		case spu_itype::IOHL:
 		{
-			m_regmod[pos / 4] = op.rt;
+			m_analysis->regmod[pos / 4] = op.rt;
 			values[op.rt] = values[op.rt] | op.i16;
 			break;
 		}
 		case spu_itype::ORI:
 		{
-			m_regmod[pos / 4] = op.rt;
+			m_analysis->regmod[pos / 4] = op.rt;
 			vflags[op.rt] = vflags[op.ra] & vf::is_const;
 			values[op.rt] = values[op.ra] | op.si10;
 			break;
 		}
 		case spu_itype::OR:
 		{
-			m_regmod[pos / 4] = op.rt;
+			m_analysis->regmod[pos / 4] = op.rt;
 			vflags[op.rt] = vflags[op.ra] & vflags[op.rb] & vf::is_const;
 			values[op.rt] = values[op.ra] | values[op.rb];
 			break;
 		}
 		case spu_itype::ANDI:
 		{
-			m_regmod[pos / 4] = op.rt;
+			m_analysis->regmod[pos / 4] = op.rt;
 			vflags[op.rt] = vflags[op.ra] & vf::is_const;
 			values[op.rt] = values[op.ra] & op.si10;
 			break;
 		}
 		case spu_itype::AND:
 		{
-			m_regmod[pos / 4] = op.rt;
+			m_analysis->regmod[pos / 4] = op.rt;
 			vflags[op.rt] = vflags[op.ra] & vflags[op.rb] & vf::is_const;
 			values[op.rt] = values[op.ra] & values[op.rb];
 			break;
 		}
 		case spu_itype::AI:
 		{
-			m_regmod[pos / 4] = op.rt;
+			m_analysis->regmod[pos / 4] = op.rt;
 			vflags[op.rt] = vflags[op.ra] & vf::is_const;
 			values[op.rt] = values[op.ra] + op.si10;
 			break;
 		}
 		case spu_itype::A:
 		{
-			m_regmod[pos / 4] = op.rt;
+			m_analysis->regmod[pos / 4] = op.rt;
 			vflags[op.rt] = vflags[op.ra] & vflags[op.rb] & vf::is_const;
 			values[op.rt] = values[op.ra] + values[op.rb];
 			break;
 		}
 		case spu_itype::SFI:
 		{
-			m_regmod[pos / 4] = op.rt;
+			m_analysis->regmod[pos / 4] = op.rt;
 			vflags[op.rt] = vflags[op.ra] & vf::is_const;
 			values[op.rt] = op.si10 - values[op.ra];
 			break;
 		}
 		case spu_itype::SF:
 		{
-			m_regmod[pos / 4] = op.rt;
+			m_analysis->regmod[pos / 4] = op.rt;
 			vflags[op.rt] = vflags[op.ra] & vflags[op.rb] & vf::is_const;
 			values[op.rt] = values[op.rb] - values[op.ra];
 			break;
 		}
 		case spu_itype::ROTMI:
 		{
-			m_regmod[pos / 4] = op.rt;
+			m_analysis->regmod[pos / 4] = op.rt;
 
 			if ((0 - op.i7) & 0x20)
 			{
@@ -2018,7 +2122,7 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 		}
 		case spu_itype::SHLI:
 		{
-			m_regmod[pos / 4] = op.rt;
+			m_analysis->regmod[pos / 4] = op.rt;
 
 			if (op.i7 & 0x20)
 			{
@@ -2036,7 +2140,7 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 		{
 			// Unconst
 			const u32 op_rt = type & spu_itype::_quadrop ? +op.rt4 : +op.rt;
-			m_regmod[pos / 4] = op_rt;
+			m_analysis->regmod[pos / 4] = op_rt;
 			vflags[op_rt] = {};
 			break;
 		}
@@ -2071,7 +2175,7 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 		// Check unreachable blocks
 		limit = std::min<u32>(limit, lsa + initial_size * 4);
 
-		for (auto& pair : m_preds)
+		for (auto& pair : m_analysis->preds)
 		{
 			bool reachable = false;
 
@@ -2098,11 +2202,11 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 						break;
 					}
 
-					const auto found = m_preds.find(j);
+					const auto found = m_analysis->preds.find(j);
 
 					bool had_fallthrough = false;
 
-					if (found != m_preds.end())
+					if (found != m_analysis->preds.end())
 					{
 						for (u32 new_pred : found->second)
 						{
@@ -2125,7 +2229,7 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 					// Check for possible fallthrough predecessor
 					if (!had_fallthrough)
 					{
-						if (result.data.at((j - lsa) / 4 - 1) == 0 || m_targets.count(j - 4))
+						if (result.data.at((j - lsa) / 4 - 1) == 0 || m_analysis->targets.count(j - 4))
 						{
 							break;
 						}
@@ -2198,19 +2302,19 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 
 		if (addr < lsa || addr >= limit || !result.data[(addr - lsa) / 4])
 		{
-			m_block_info[addr / 4] = false;
-			m_entry_info[addr / 4] = false;
-			m_ret_info[addr / 4] = false;
-			m_preds.erase(addr);
+			m_analysis->block_info[addr / 4] = false;
+			m_analysis->entry_info[addr / 4] = false;
+			m_analysis->ret_info[addr / 4] = false;
+			m_analysis->preds.erase(addr);
 		}
 	}
 
-	// Complete m_preds and associated m_targets for adjacent blocks
-	for (auto it = m_preds.begin(); it != m_preds.end();)
+	// Complete m_analysis->preds and associated m_analysis->targets for adjacent blocks
+	for (auto it = m_analysis->preds.begin(); it != m_analysis->preds.end();)
 	{
 		if (it->first < lsa || it->first >= limit)
 		{
-			it = m_preds.erase(it);
+			it = m_analysis->preds.erase(it);
 			continue;
 		}
 
@@ -2223,11 +2327,11 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 		it->second.erase(new_end, it->second.end());
 
 		// Don't add fallthrough target if all predecessors are removed
-		if (it->second.empty() && !m_entry_info[it->first / 4])
+		if (it->second.empty() && !m_analysis->entry_info[it->first / 4])
 		{
 			// If not an entry point, remove the block completely
-			m_block_info[it->first / 4] = false;
-			it = m_preds.erase(it);
+			m_analysis->block_info[it->first / 4] = false;
+			it = m_analysis->preds.erase(it);
 			continue;
 		}
 
@@ -2235,10 +2339,10 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 		const u32 prev = (it->first - 4) & 0x3fffc;
 
 		// TODO: check the correctness
-		if (m_targets.count(prev) == 0 && prev >= lsa && prev < limit && result.data[(prev - lsa) / 4])
+		if (m_analysis->targets.count(prev) == 0 && prev >= lsa && prev < limit && result.data[(prev - lsa) / 4])
 		{
 			// Add target and the predecessor
-			m_targets[prev].push_back(it->first);
+			m_analysis->targets[prev].push_back(it->first);
 			it->second.push_back(prev);
 		}
 
@@ -2246,11 +2350,11 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 	}
 
 	// Remove unnecessary target lists
-	for (auto it = m_targets.begin(); it != m_targets.end();)
+	for (auto it = m_analysis->targets.begin(); it != m_analysis->targets.end();)
 	{
 		if (it->first < lsa || it->first >= limit)
 		{
-			it = m_targets.erase(it);
+			it = m_analysis->targets.erase(it);
 			continue;
 		}
 
@@ -2287,9 +2391,19 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 	}
 
 	// Fill block info
-	for (auto& pred : m_preds)
+	for (auto& pred : m_analysis->preds)
 	{
-		auto& block = m_bbs[pred.first];
+		if (!m_analysis->bb_pool.empty() && !m_analysis->bbs.count(pred.first))
+		{
+			// Reuse a block node
+			auto node = std::move(m_analysis->bb_pool.back());
+			m_analysis->bb_pool.pop_back();
+			node.key() = pred.first;
+			node.mapped() = block_info{};
+			m_analysis->bbs.insert(std::move(node));
+		}
+
+		auto& block = m_analysis->bbs[pred.first];
 
 		// Copy predeccessors (wrong at this point, needs a fixup later)
 		block.preds = pred.second;
@@ -2314,7 +2428,7 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 				reg_save = op.rt;
 			}
 
-			for (auto* _use : {&m_use_ra, &m_use_rb, &m_use_rc})
+			for (auto* _use : {&m_analysis->use_ra, &m_analysis->use_rb, &m_analysis->use_rc})
 			{
 				if (u8 reg = (*_use)[ia / 4]; reg < s_reg_max)
 				{
@@ -2332,7 +2446,7 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 				}
 			}
 
-			if (m_use_rb[ia / 4] == s_reg_mfc_eal)
+			if (m_analysis->use_rb[ia / 4] == s_reg_mfc_eal)
 			{
 				// Expand MFC_Cmd reg use
 				for (u8 reg : {s_reg_mfc_lsa, s_reg_mfc_tag, s_reg_mfc_size})
@@ -2343,7 +2457,7 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 			}
 
 			// Register reg modification
-			if (u8 reg = m_regmod[ia / 4]; reg < s_reg_max)
+			if (u8 reg = m_analysis->regmod[ia / 4]; reg < s_reg_max)
 			{
 				block.reg_mod.set(reg);
 				block.reg_mod_xf.set(reg, type & spu_itype::xfloat);
@@ -2359,9 +2473,9 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 			}
 
 			// Find targets (also means end of the block)
-			const auto tfound = m_targets.find(ia);
+			const auto tfound = m_analysis->targets.find(ia);
 
-			if (tfound != m_targets.end())
+			if (tfound != m_analysis->targets.end())
 			{
 				// Copy targets
 				block.targets = tfound->second;
@@ -2413,24 +2527,24 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 	}
 
 	// Fixup block predeccessors to point to basic blocks, not last instructions
-	for (auto& bb : m_bbs)
+	for (auto& bb : m_analysis->bbs)
 	{
 		const u32 addr = bb.first;
 
 		for (u32& pred : bb.second.preds)
 		{
-			pred = std::prev(m_bbs.upper_bound(pred))->first;
+			pred = std::prev(m_analysis->bbs.upper_bound(pred))->first;
 		}
 
-		if (m_entry_info[addr / 4] && g_cfg.core.spu_block_size == spu_block_size_type::giga)
+		if (m_analysis->entry_info[addr / 4] && g_cfg.core.spu_block_size == spu_block_size_type::giga)
 		{
 			// Register empty chunk
-			m_chunks.push_back(addr);
+			m_analysis->chunks.push_back(addr);
 
 			// Register function if necessary
-			if (!m_ret_info[addr / 4])
+			if (!m_analysis->ret_info[addr / 4])
 			{
-				m_funcs[addr];
+				m_analysis->funcs[addr];
 			}
 		}
 	}
@@ -2438,12 +2552,12 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 	// Ensure there is a function at the lowest address
 	if (g_cfg.core.spu_block_size == spu_block_size_type::giga)
 	{
-		if (auto emp = m_funcs.try_emplace(m_bbs.begin()->first); emp.second)
+		if (auto emp = m_analysis->funcs.try_emplace(m_analysis->bbs.begin()->first); emp.second)
 		{
 			const u32 addr = emp.first->first;
 			spu_log.error("[0x%05x] Fixed first function at 0x%05x", entry_point, addr);
-			m_entry_info[addr / 4] = true;
-			m_ret_info[addr / 4] = false;
+			m_analysis->entry_info[addr / 4] = true;
+			m_analysis->ret_info[addr / 4] = false;
 		}
 	}
 
@@ -2456,37 +2570,37 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 		u32 limit = 0x40000;
 
 		// Walk block list in ascending order
-		for (auto& block : m_bbs)
+		for (auto& block : m_analysis->bbs)
 		{
 			const u32 addr = block.first;
 
-			if (m_entry_info[addr / 4] && !m_ret_info[addr / 4])
+			if (m_analysis->entry_info[addr / 4] && !m_analysis->ret_info[addr / 4])
 			{
-				const auto upper = m_funcs.upper_bound(addr);
+				const auto upper = m_analysis->funcs.upper_bound(addr);
 				start = addr;
-				limit = upper == m_funcs.end() ? 0x40000 : upper->first;
+				limit = upper == m_analysis->funcs.end() ? 0x40000 : upper->first;
 			}
 
 			// Find targets that exceed [start; limit) range and make new functions from them
 			for (u32 target : block.second.targets)
 			{
-				const auto tfound = m_bbs.find(target);
+				const auto tfound = m_analysis->bbs.find(target);
 
-				if (tfound == m_bbs.end())
+				if (tfound == m_analysis->bbs.end())
 				{
 					continue;
 				}
 
 				if (target < start || target >= limit)
 				{
-					if (!m_entry_info[target / 4] || m_ret_info[target / 4])
+					if (!m_analysis->entry_info[target / 4] || m_analysis->ret_info[target / 4])
 					{
 						// Create new function entry (likely a tail call)
-						m_entry_info[target / 4] = true;
+						m_analysis->entry_info[target / 4] = true;
 
-						m_ret_info[target / 4] = false;
+						m_analysis->ret_info[target / 4] = false;
 
-						m_funcs.try_emplace(target);
+						m_analysis->funcs.try_emplace(target);
 
 						if (target < limit)
 						{
@@ -2516,15 +2630,15 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 		for (u32 wi = 0; wi < workload.size(); wi++)
 		{
 			const u32 addr = workload[wi];
-			auto& block    = m_bbs.at(addr);
+			auto& block    = m_analysis->bbs.at(addr);
 			const u32 _new = block.chunk;
 
-			if (!m_entry_info[addr / 4])
+			if (!m_analysis->entry_info[addr / 4])
 			{
 				// Check block predecessors
 				for (u32 pred : block.preds)
 				{
-					const u32 _old = m_bbs.at(pred).chunk;
+					const u32 _old = m_analysis->bbs.at(pred).chunk;
 
 					if (_old < 0x40000 && _old != _new)
 					{
@@ -2535,26 +2649,26 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 			}
 
 			// Update chunk address
-			block.chunk = m_entry_info[addr / 4] ? addr : _new;
+			block.chunk = m_analysis->entry_info[addr / 4] ? addr : _new;
 
 			// Process block targets
 			for (u32 target : block.targets)
 			{
-				const auto tfound = m_bbs.find(target);
+				const auto tfound = m_analysis->bbs.find(target);
 
-				if (tfound == m_bbs.end())
+				if (tfound == m_analysis->bbs.end())
 				{
 					continue;
 				}
 
 				auto& tb = tfound->second;
 
-				const u32 value = m_entry_info[target / 4] ? target : block.chunk;
+				const u32 value = m_analysis->entry_info[target / 4] ? target : block.chunk;
 
 				if (u32& tval = tb.chunk; tval < 0x40000)
 				{
 					// TODO: fix condition
-					if (tval != value && !m_entry_info[target / 4])
+					if (tval != value && !m_analysis->entry_info[target / 4])
 					{
 						new_entries.push_back(target);
 					}
@@ -2574,13 +2688,13 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 
 		for (u32 entry : new_entries)
 		{
-			m_entry_info[entry / 4] = true;
+			m_analysis->entry_info[entry / 4] = true;
 
 			// Acknowledge artificial (reversible) chunk entry point
-			m_ret_info[entry / 4] = true;
+			m_analysis->ret_info[entry / 4] = true;
 		}
 
-		for (auto& bb : m_bbs)
+		for (auto& bb : m_analysis->bbs)
 		{
 			// Reset chunk info
 			bb.second.chunk = 0x40000;
@@ -2594,14 +2708,14 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 	for (u32 wi = 0; wi < workload.size(); wi++)
 	{
 		const u32 addr  = workload[wi];
-		auto& block     = m_bbs.at(addr);
+		auto& block     = m_analysis->bbs.at(addr);
 		block.analysed  = true;
 
 		for (u32 target : block.targets)
 		{
-			const auto tfound = m_bbs.find(target);
+			const auto tfound = m_analysis->bbs.find(target);
 
-			if (tfound == m_bbs.end())
+			if (tfound == m_analysis->bbs.end())
 			{
 				continue;
 			}
@@ -2637,10 +2751,10 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 		for (u32 wi = 0; wi < workload.size(); wi++)
 		{
 			const u32 addr = workload[wi];
-			auto& block    = m_bbs.at(addr);
+			auto& block    = m_analysis->bbs.at(addr);
 
 			// Initialize entry point with default value: unknown origin (requires load)
-			if (m_entry_info[addr / 4])
+			if (m_analysis->entry_info[addr / 4])
 			{
 				for (u32 i = 0; i < s_reg_max; i++)
 				{
@@ -2649,7 +2763,7 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 				}
 			}
 
-			if (g_cfg.core.spu_block_size == spu_block_size_type::giga && m_entry_info[addr / 4] && !m_ret_info[addr / 4])
+			if (g_cfg.core.spu_block_size == spu_block_size_type::giga && m_analysis->entry_info[addr / 4] && !m_analysis->ret_info[addr / 4])
 			{
 				for (u32 i = 0; i < s_reg_max; i++)
 				{
@@ -2662,9 +2776,9 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 
 			for (u32 target : block.targets)
 			{
-				const auto tfound = m_bbs.find(target);
+				const auto tfound = m_analysis->bbs.find(target);
 
-				if (tfound == m_bbs.end())
+				if (tfound == m_analysis->bbs.end())
 				{
 					continue;
 				}
@@ -2727,7 +2841,7 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 		for (u32 wi = 0; wi < workload.size(); wi++)
 		{
 			const u32 addr = workload[wi];
-			auto& block    = m_bbs.at(addr);
+			auto& block    = m_analysis->bbs.at(addr);
 
 			// Reset values for the next attempt (keep negative values)
 			for (u32 i = 0; i < s_reg_max; i++)
@@ -2749,8 +2863,8 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 		}
 
 		const u32 addr = workload[wi];
-		auto& bb       = m_bbs.at(addr);
-		auto& func     = m_funcs.at(bb.func);
+		auto& bb       = m_analysis->bbs.at(addr);
+		auto& func     = m_analysis->funcs.at(bb.func);
 
 		// Update function size
 		func.size = std::max<u16>(func.size, bb.size + (addr - bb.func) / 4);
@@ -2762,7 +2876,7 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 
 			if (orig < 0x40000)
 			{
-				auto& src = m_bbs.at(orig);
+				auto& src = m_analysis->bbs.at(orig);
 				bb.reg_const[i] = src.reg_const[i];
 				bb.reg_val32[i] = src.reg_val32[i];
 			}
@@ -2776,7 +2890,7 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 
 		if (u32 orig = bb.reg_origin_abs[s_reg_sp]; orig < 0x40000)
 		{
-			auto& prologue = m_bbs.at(orig);
+			auto& prologue = m_analysis->bbs.at(orig);
 
 			// Copy stack offset (from the assumed prologue)
 			bb.stack_sub = prologue.stack_sub;
@@ -2900,14 +3014,14 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 			default:
 			{
 				// Clear const if reg is modified here
-				if (u8 reg = m_regmod[ia / 4]; reg < s_reg_max)
+				if (u8 reg = m_analysis->regmod[ia / 4]; reg < s_reg_max)
 					bb.reg_const[reg] = false;
 				break;
 			}
 			}
 
 			// $SP is modified
-			if (m_regmod[ia / 4] == s_reg_sp)
+			if (m_analysis->regmod[ia / 4] == s_reg_sp)
 			{
 				if (bb.reg_const[s_reg_sp])
 				{
@@ -3075,7 +3189,7 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 	}
 
 	// Check function blocks, verify and print some reasons
-	for (auto& f : m_funcs)
+	for (auto& f : m_analysis->funcs)
 	{
 		if (g_cfg.core.spu_block_size != spu_block_size_type::giga)
 		{
@@ -3086,10 +3200,10 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 
 		u32 used_stack = 0;
 
-		for (auto it = m_bbs.lower_bound(f.first); it != m_bbs.end() && it->second.func == f.first; ++it)
+		for (auto it = m_analysis->bbs.lower_bound(f.first); it != m_analysis->bbs.end() && it->second.func == f.first; ++it)
 		{
 			auto& bb       = it->second;
-			auto& func     = m_funcs.at(bb.func);
+			auto& func     = m_analysis->funcs.at(bb.func);
 			const u32 addr = it->first;
 			const u32 flim = bb.func + func.size * 4;
 
@@ -3105,7 +3219,7 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 				// Check $LR (alternative return registers are currently not supported)
 				if (u32 lr_orig = bb.reg_mod[s_reg_lr] ? addr : bb.reg_origin_abs[s_reg_lr]; lr_orig < 0x40000)
 				{
-					auto& src = m_bbs.at(lr_orig);
+					auto& src = m_analysis->bbs.at(lr_orig);
 
 					if (src.reg_load_mod[s_reg_lr] != func.reg_save_off[s_reg_lr])
 					{
@@ -3129,7 +3243,7 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 				{
 					if (u32 orig = bb.reg_mod[i] ? addr : bb.reg_origin_abs[i]; orig < 0x40000)
 					{
-						auto& src = m_bbs.at(orig);
+						auto& src = m_analysis->bbs.at(orig);
 
 						if (src.reg_load_mod[i] != func.reg_save_off[i])
 						{
@@ -3218,7 +3332,7 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 	{
 		bool need_repeat = false;
 
-		for (auto& f : m_funcs)
+		for (auto& f : m_analysis->funcs)
 		{
 			if (!f.second.good)
 			{
@@ -3227,9 +3341,9 @@ spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 
 			for (u32 call : f.second.calls)
 			{
-				const auto ffound = std::as_const(m_funcs).find(call);
+				const auto ffound = std::as_const(m_analysis->funcs).find(call);
 
-				if (ffound == m_funcs.cend() || ffound->second.good == false)
+				if (ffound == m_analysis->funcs.cend() || ffound->second.good == false)
 				{
 					need_repeat = true;
 
@@ -3273,7 +3387,7 @@ void spu_recompiler_base::dump(const spu_program& result, std::string& out)
 
 	fmt::append(out, "========== SPU BLOCK 0x%05x (size %u, %s) ==========\n", result.entry_point, result.data.size(), hash);
 
-	for (auto& bb : m_bbs)
+	for (auto& bb : m_analysis->bbs)
 	{
 		for (u32 pos = bb.first, end = bb.first + bb.second.size * 4; pos < end; pos += 4)
 		{
@@ -3281,9 +3395,9 @@ void spu_recompiler_base::dump(const spu_program& result, std::string& out)
 			fmt::append(out, ">%s\n", dis_asm.last_opcode);
 		}
 
-		if (m_block_info[bb.first / 4])
+		if (m_analysis->block_info[bb.first / 4])
 		{
-			fmt::append(out, "A: [0x%05x] %s\n", bb.first, m_entry_info[bb.first / 4] ? (m_ret_info[bb.first / 4] ? "Chunk" : "Entry") : "Block");
+			fmt::append(out, "A: [0x%05x] %s\n", bb.first, m_analysis->entry_info[bb.first / 4] ? (m_analysis->ret_info[bb.first / 4] ? "Chunk" : "Entry") : "Block");
 
 			fmt::append(out, "\tF: 0x%05x\n", bb.second.func);
 
@@ -3294,7 +3408,7 @@ void spu_recompiler_base::dump(const spu_program& result, std::string& out)
 
 			for (u32 target : bb.second.targets)
 			{
-				fmt::append(out, "\t-> 0x%05x%s\n", target, m_bbs.count(target) ? "" : " (null)");
+				fmt::append(out, "\t-> 0x%05x%s\n", target, m_analysis->bbs.count(target) ? "" : " (null)");
 			}
 		}
 		else
@@ -3305,7 +3419,7 @@ void spu_recompiler_base::dump(const spu_program& result, std::string& out)
 		out += '\n';
 	}
 
-	for (auto& f : m_funcs)
+	for (auto& f : m_analysis->funcs)
 	{
 		fmt::append(out, "F: [0x%05x]%s\n", f.first, f.second.good ? " (good)" : " (bad)");
 
@@ -3313,13 +3427,36 @@ void spu_recompiler_base::dump(const spu_program& result, std::string& out)
 
 		for (u32 call : f.second.calls)
 		{
-			fmt::append(out, "\t>> 0x%05x%s\n", call, m_funcs.count(call) ? "" : " (null)");
+			fmt::append(out, "\t>> 0x%05x%s\n", call, m_analysis->funcs.count(call) ? "" : " (null)");
 		}
 	}
 
 	out += '\n';
 }
 
+void spu_recompiler_base::swap_analysis(spu_recompiler_base& other) noexcept
+{
+	m_analysis.swap(other.m_analysis);
+}
+
+// Analyser-only instance
+struct spu_analyser_only final : public spu_recompiler_base
+{
+	virtual void init() override
+	{
+	}
+
+	virtual spu_function_t compile(spu_program&&) override
+	{
+		return nullptr;
+	}
+};
+
+std::unique_ptr<spu_recompiler_base> spu_recompiler_base::make_analyser()
+{
+	return std::make_unique<spu_analyser_only>();
+}
+
 #ifdef LLVM_AVAILABLE
 
 #include "Emu/CPU/CPUTranslator.h"
@@ -3505,9 +3642,9 @@ class spu_llvm_recompiler : public spu_recompiler_base, public cpu_translator
 		if (g_cfg.core.spu_block_size == spu_block_size_type::giga)
 		{
 			// Find good real function
-			const auto ffound = m_funcs.find(addr);
+			const auto ffound = m_analysis->funcs.find(addr);
 
-			if (ffound != m_funcs.end() && ffound->second.good)
+			if (ffound != m_analysis->funcs.end() && ffound->second.good)
 			{
 				// Real function type (not equal to chunk type)
 				// 4. $SP
@@ -3659,7 +3796,7 @@ class spu_llvm_recompiler : public spu_recompiler_base, public cpu_translator
 	llvm::BasicBlock* add_block(u32 target, bool absolute = false)
 	{
 		// Check the predecessor
-		const bool pred_found = m_block_info[target / 4] && m_preds[target].find_first_of(m_pos) + 1;
+		const bool pred_found = m_analysis->block_info[target / 4] && m_analysis->preds[target].find_first_of(m_pos) + 1;
 
 		if (m_blocks.empty())
 		{
@@ -3696,7 +3833,7 @@ class spu_llvm_recompiler : public spu_recompiler_base, public cpu_translator
 				m_finfo->load[3] = &*(fn->arg_begin() + 4);
 			}
 		}
-		else if (m_block_info[target / 4] && m_entry_info[target / 4] && !(pred_found && m_entry == target) && (!m_finfo->fn || !m_ret_info[target / 4]))
+		else if (m_analysis->block_info[target / 4] && m_analysis->entry_info[target / 4] && !(pred_found && m_entry == target) && (!m_finfo->fn || !m_analysis->ret_info[target / 4]))
 		{
 			// Generate a tail call to the function chunk
 			const auto cblock = m_ir->GetInsertBlock();
@@ -3735,9 +3872,9 @@ class spu_llvm_recompiler : public spu_recompiler_base, public cpu_translator
 			m_ir->SetInsertPoint(cblock);
 			return result;
 		}
-		else if (!pred_found || !m_block_info[target / 4])
+		else if (!pred_found || !m_analysis->block_info[target / 4])
 		{
-			if (m_block_info[target / 4])
+			if (m_analysis->block_info[target / 4])
 			{
 				spu_log.error("[%s] [0x%x] Predecessor not found for target 0x%x (chunk=0x%x, entry=0x%x, size=%u)", m_hash, m_pos, target, m_entry, m_function_queue[0], m_size / 4);
 			}
@@ -4147,7 +4284,7 @@ class spu_llvm_recompiler : public spu_recompiler_base, public cpu_translator
 		llvm::StoreInst* dummy{};
 
 		// Check
-		ensure(!m_block || m_regmod[m_pos / 4] == index);
+		ensure(!m_block || m_analysis->regmod[m_pos / 4] == index);
 
 		// Test for special case
 		const bool is_xfloat = value->getType() == get_type<f64[4]>();
@@ -4707,7 +4844,7 @@ public:
 				const u32 baddr = m_block_queue[bi];
 				m_block = &m_blocks[baddr];
 				m_ir->SetInsertPoint(m_block->block);
-				auto& bb = m_bbs.at(baddr);
+				auto& bb = m_analysis->bbs.at(baddr);
 				bool need_check = false;
 				m_block->bb = &bb;
 
@@ -4821,7 +4958,7 @@ public:
 				// Emit instructions
 				for (m_pos = baddr; m_pos >= start && m_pos < end && !m_ir->GetInsertBlock()->getTerminator(); m_pos += 4)
 				{
-					if (m_pos != baddr && m_block_info[m_pos / 4])
+					if (m_pos != baddr && m_analysis->block_info[m_pos / 4])
 					{
 						break;
 					}
@@ -4855,9 +4992,9 @@ public:
 
 						if (target >= start && target < end)
 						{
-							const auto tfound = m_targets.find(m_pos);
+							const auto tfound = m_analysis->targets.find(m_pos);
 
-							if (tfound == m_targets.end() || tfound->second.find_first_of(target) + 1 == 0)
+							if (tfound == m_analysis->targets.end() || tfound->second.find_first_of(target) + 1 == 0)
 							{
 								spu_log.error("[%s] Unregistered fallthrough to 0x%x (chunk=0x%x, entry=0x%x)", m_hash, target, m_entry, m_function_queue[0]);
 							}
@@ -9483,9 +9620,9 @@ public:
 		}
 
 		// Create jump table if necessary (TODO)
-		const auto tfound = m_targets.find(m_pos);
+		const auto tfound = m_analysis->targets.find(m_pos);
 
-		if (!op.d && !op.e && tfound != m_targets.end() && tfound->second.size() > 1)
+		if (!op.d && !op.e && tfound != m_analysis->targets.end() && tfound->second.size() > 1)
 		{
 			// Shift aligned address for switch
 			const auto addrfx = m_ir->CreateSub(addr.value, m_base_pc);
@@ -9496,7 +9633,7 @@ public:
 
 			for (u32 target : tfound->second)
 			{
-				if (m_block_info[target / 4])
+				if (m_analysis->block_info[target / 4])
 				{
 					targets.emplace(target, nullptr);
 				}
@@ -9525,7 +9662,7 @@ public:
 
 			for (u32 pos = start; pos < end; pos += 4)
 			{
-				if (m_block_info[pos / 4] && targets.count(pos))
+				if (m_analysis->block_info[pos / 4] && targets.count(pos))
 				{
 					const auto found = targets.find(pos);
 
@@ -9908,7 +10045,7 @@ public:
 			return;
 		}
 
-		if (g_cfg.core.spu_block_size >= spu_block_size_type::mega && m_block_info[m_pos / 4 + 1] && m_entry_info[m_pos / 4 + 1])
+		if (g_cfg.core.spu_block_size >= spu_block_size_type::mega && m_analysis->block_info[m_pos / 4 + 1] && m_analysis->entry_info[m_pos / 4 + 1])
 		{
 			// Store the return function chunk address at the stack mirror
 			const auto pfunc = add_function(m_pos + 4);
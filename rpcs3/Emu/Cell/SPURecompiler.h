@@ -53,6 +53,123 @@ struct spu_program
 	bool operator<(const spu_program& rhs) const noexcept;
 };
 
+// Flat map of LS instruction addresses to address lists, keeps its storage between the analyser runs
+class spu_addr_map
+{
+public:
+	using value_type = std::pair<u32, std::basic_string<u32>>;
+	using iterator = value_type*;
+
+private:
+	// Entries (only the first m_size are valid, the rest keep their capacity for reuse)
+	std::vector<value_type> m_data;
+
+	usz m_size = 0;
+
+	// Entry index + 1 for every instruction in LS (0 if not present)
+	std::array<u32, 0x10000> m_index{};
+
+public:
+	iterator begin() noexcept
+	{
+		return m_data.data();
+	}
+
+	iterator end() noexcept
+	{
+		return m_data.data() + m_size;
+	}
+
+	usz size() const noexcept
+	{
+		return m_size;
+	}
+
+	iterator find(u32 addr) noexcept
+	{
+		const u32 index = m_index[addr / 4 % 0x10000];
+		return index ? m_data.data() + (index - 1) : end();
+	}
+
+	usz count(u32 addr) const noexcept
+	{
+		return m_index[addr / 4 % 0x10000] != 0;
+	}
+
+	// Insert if not present (may invalidate iterators)
+	std::pair<iterator, bool> try_emplace(u32 addr)
+	{
+		if (const u32 index = m_index[addr / 4 % 0x10000])
+		{
+			return {m_data.data() + (index - 1), false};
+		}
+
+		if (m_size == m_data.size())
+		{
+			m_data.emplace_back();
+		}
+
+		auto& entry = m_data[m_size++];
+		entry.first = addr;
+		entry.second.clear();
+		m_index[addr / 4 % 0x10000] = static_cast<u32>(m_size);
+		return {&entry, true};
+	}
+
+	std::pair<iterator, bool> emplace(u32 addr, std::basic_string<u32>&& list)
+	{
+		auto [it, ok] = try_emplace(addr);
+
+		if (ok)
+		{
+			it->second = std::move(list);
+		}
+
+		return {it, ok};
+	}
+
+	std::basic_string<u32>& operator[](u32 addr)
+	{
+		return try_emplace(addr).first->second;
+	}
+
+	// Erase by moving the last entry in place, returns the iterator to the next unvisited entry
+	iterator erase(iterator it) noexcept
+	{
+		const usz index = it - m_data.data();
+		m_index[it->first / 4 % 0x10000] = 0;
+
+		if (index != --m_size)
+		{
+			std::swap(m_data[index], m_data[m_size]);
+			m_index[m_data[index].first / 4 % 0x10000] = static_cast<u32>(index + 1);
+		}
+
+		return it;
+	}
+
+	usz erase(u32 addr) noexcept
+	{
+		if (const auto it = find(addr); it != end())
+		{
+			erase(it);
+			return 1;
+		}
+
+		return 0;
+	}
+
+	void clear() noexcept
+	{
+		for (usz i = 0; i < m_size; i++)
+		{
+			m_index[m_data[i].first / 4 % 0x10000] = 0;
+		}
+
+		m_size = 0;
+	}
+};
+
 class spu_item
 {
 public:
@@ -163,7 +280,7 @@ public:
 		s_reg_mfc_tag,
 		s_reg_mfc_size,
 
-		// Max number of registers (for m_regmod)
+		// Max number of registers (for analysis_state::regmod)
 		s_reg_max
 	};
 
@@ -185,28 +302,6 @@ protected:
 	u32 m_size;
 	u64 m_hash_start;
 
-	// Bit indicating start of the block
-	std::bitset<0x10000> m_block_info;
-
-	// GPR modified by the instruction (-1 = not set)
-	std::array<u8, 0x10000> m_regmod;
-
-	std::array<u8, 0x10000> m_use_ra;
-	std::array<u8, 0x10000> m_use_rb;
-	std::array<u8, 0x10000> m_use_rc;
-
-	// List of possible targets for the instruction (entry shouldn't exist for simple instructions)
-	std::unordered_map<u32, std::basic_string<u32>, value_hash<u32, 2>> m_targets;
-
-	// List of block predecessors
-	std::unordered_map<u32, std::basic_string<u32>, value_hash<u32, 2>> m_preds;
-
-	// List of function entry points and return points (set after BRSL, BRASL, BISL, BISLED)
-	std::bitset<0x10000> m_entry_info;
-
-	// Set after return points and disjoint chunks
-	std::bitset<0x10000> m_ret_info;
-
 	// Basic block information
 	struct block_info
 	{
@@ -262,12 +357,6 @@ protected:
 		std::basic_string<u32> preds;
 	};
 
-	// Sorted basic block info
-	std::map<u32, block_info> m_bbs;
-
-	// Sorted advanced block (chunk) list
-	std::basic_string<u32> m_chunks;
-
 	// Function information
 	struct func_info
 	{
@@ -284,8 +373,49 @@ protected:
 		std::array<u32, s_reg_max> reg_save_off{};
 	};
 
-	// Sorted function info
-	std::map<u32, func_info> m_funcs;
+	// Analyser results and storage (about 2 MiB, heap allocated so that it can be handed over cheaply)
+	struct analysis_state
+	{
+		// Bit indicating start of the block
+		std::bitset<0x10000> block_info;
+
+		// GPR modified by the instruction (-1 = not set)
+		std::array<u8, 0x10000> regmod;
+
+		std::array<u8, 0x10000> use_ra;
+		std::array<u8, 0x10000> use_rb;
+		std::array<u8, 0x10000> use_rc;
+
+		// Range of instructions (regmod, use_ra, use_rb, use_rc) touched by the last analysis
+		u32 dirty_begin = 0;
+		u32 dirty_end = 0x10000;
+
+		// List of possible targets for the instruction (entry shouldn't exist for simple instructions)
+		spu_addr_map targets;
+
+		// List of block predecessors
+		spu_addr_map preds;
+
+		// List of function entry points and return points (set after BRSL, BRASL, BISL, BISLED)
+		std::bitset<0x10000> entry_info;
+
+		// Set after return points and disjoint chunks
+		std::bitset<0x10000> ret_info;
+
+		// Sorted basic block info
+		std::map<u32, spu_recompiler_base::block_info> bbs;
+
+		// Sorted advanced block (chunk) list
+		std::basic_string<u32> chunks;
+
+		// Sorted function info
+		std::map<u32, func_info> funcs;
+
+		// Unused nodes of bbs kept for reuse
+		std::vector<std::map<u32, spu_recompiler_base::block_info>::node_type> bb_pool;
+	};
+
+	std::unique_ptr<analysis_state> m_analysis;
 
 private:
 	// For private use
@@ -320,6 +450,9 @@ public:
 	// Print analyser internal state
 	void dump(const spu_program& result, std::string& out);
 
+	// Exchange analyser internal state with another instance (allows to analyse ahead of compilation)
+	void swap_analysis(spu_recompiler_base& other) noexcept;
+
 	// Get SPU Runtime
 	spu_runtime& get_runtime()
 	{
@@ -339,4 +472,7 @@ public:
 
 	// Create recompiler instance (interpreter-based LLVM)
 	static std::unique_ptr<spu_recompiler_base> make_fast_llvm_recompiler();
+
+	// Create analyser-only instance (cannot compile)
+	static std::unique_ptr<spu_recompiler_base> make_analyser();
 };
@@ -319,6 +319,8 @@ void do_cell_atomic_128_store(u32 addr, const void* to_write);
 
 extern thread_local u64 g_tls_fault_spu;
 
+extern bool spursKernelHleStop(spu_thread& spu, u32 code);
+
 const spu_decoder<spu_itype> s_spu_itype;
 
 namespace spu
@@ -1422,6 +1424,12 @@ void spu_thread::cpu_task()
 
 	pc &= 0x3fffc;
 
+	// Apply host cache domain placement of the thread group
+	if (const u64 mask = group ? group->affinity_mask.load() : 0)
+	{
+		thread_ctrl::set_thread_affinity_mask(mask);
+	}
+
 	std::fesetround(FE_TOWARDZERO);
 
 	gv_set_zeroing_denormals();
@@ -4494,6 +4502,12 @@ bool spu_thread::stop_and_signal(u32 code)
 		return true;
 	}
 
+	if (spurs_hle_kernel && spursKernelHleStop(*this, code))
+	{
+		// Resume at the return address set by the HLE function
+		return false;
+	}
+
 	auto get_queue = [this](u32 spuq) -> const std::shared_ptr<lv2_event_queue>&
 	{
 		for (auto& v : this->spuq)
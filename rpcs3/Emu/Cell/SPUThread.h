@@ -788,6 +788,7 @@ public:
 	const spu_type thread_type;
 	const u32 option; // sys_spu_thread_initialize option
 	const u32 lv2_id; // The actual id that is used by syscalls
+	u32 spurs_hle_kernel = 0; // SPURS kernel version (1 or 2) whose workload selection runs as HLE, 0 if none
 
 	// Thread name
 	atomic_ptr<std::string> spu_tname;
@@ -13,6 +13,7 @@
 #include "Utilities/StrUtil.h"
 
 #include <charconv>
+#include <unordered_map>
 
 LOG_CHANNEL(sys_fs);
 
@@ -195,53 +196,140 @@ lv2_fs_mount_point* lv2_fs_object::get_mp(std::string_view filename)
 	return &g_mp_sys_dev_root;
 }
 
-u64 lv2_file::op_read(const fs::file& file, vm::ptr<void> buf, u64 size)
+// Throughput of guest file I/O, reported on emulation stop
+struct lv2_fs_io_stats
 {
-	// Copy data from intermediate buffer (avoid passing vm pointer to a native API)
-	uchar local_buf[65536];
+	struct path_stats
+	{
+		atomic_t<u64> bytes{};
+		atomic_t<u64> usecs{};
 
-	u64 result = 0;
+		void add(u64 size, u64 start)
+		{
+			bytes += size;
+			usecs += get_system_time() - start;
+		}
+	};
 
-	while (result < size)
+	path_stats read, write;
+
+	lv2_fs_io_stats() = default;
+
+	lv2_fs_io_stats(const lv2_fs_io_stats&) = delete;
+
+	lv2_fs_io_stats& operator=(const lv2_fs_io_stats&) = delete;
+
+	~lv2_fs_io_stats()
 	{
-		const u64 block = std::min<u64>(size - result, sizeof(local_buf));
-		const u64 nread = file.read(+local_buf, block);
+		const auto report = [](std::string_view name, const path_stats& stats)
+		{
+			if (const u64 bytes = stats.bytes)
+			{
+				const u64 usecs = std::max<u64>(stats.usecs, 1);
+				sys_fs.notice("%s: %u MiB in %.3fs (%.1f MB/s)", name, bytes >> 20, usecs / 1000000., bytes / static_cast<f64>(usecs));
+			}
+		};
 
-		std::memcpy(static_cast<uchar*>(buf.get_ptr()) + result, local_buf, nread);
-		result += nread;
+		report("Reads", read);
+		report("Writes", write);
+	}
+};
+
+// Transfer data between a file and guest memory, op(ptr, done, count) accesses the file at the relative position "done" (returns umax if not supported)
+template <bool IsWrite, typename F>
+static u64 fs_guest_op(u32 buf, u64 size, F&& op)
+{
+	// Use an intermediate buffer (avoid passing vm pointer to a native API)
+	// Guest memory is only touched by memcpy through vm::base, so unmapped pages and RSX protected pages go through the access violation handler
+	uchar local_buf[65536];
+	uchar* bounce = local_buf;
+	u64 bounce_size = sizeof(local_buf);
 
-		if (nread < block)
+	// Large transfers use a bigger thread local buffer to cut the number of host calls
+	thread_local std::unique_ptr<uchar[]> s_large_buf;
+
+	if (size > sizeof(local_buf))
+	{
+		if (!s_large_buf)
 		{
-			break;
+			s_large_buf = std::make_unique<uchar[]>(0x100000);
 		}
+
+		bounce = s_large_buf.get();
+		bounce_size = 0x100000;
 	}
 
-	return result;
-}
+	auto& stats = g_fxo->get<lv2_fs_io_stats>();
 
-u64 lv2_file::op_write(const fs::file& file, vm::cptr<void> buf, u64 size)
-{
-	// Copy data to intermediate buffer (avoid passing vm pointer to a native API)
-	uchar local_buf[65536];
+	const u64 start = get_system_time();
 
 	u64 result = 0;
 
 	while (result < size)
 	{
-		const u64 block = std::min<u64>(size - result, sizeof(local_buf));
-		std::memcpy(local_buf, static_cast<const uchar*>(buf.get_ptr()) + result, block);
-		const u64 nwrite = file.write(+local_buf, block);
-		result += nwrite;
+		const u64 block = std::min<u64>(size - result, bounce_size);
 
-		if (nwrite < block)
+		if constexpr (IsWrite)
+		{
+			std::memcpy(bounce, vm::base(buf + static_cast<u32>(result)), block);
+		}
+
+		const u64 ndone = op(bounce, result, block);
+
+		if (ndone == umax)
+		{
+			return umax;
+		}
+
+		if constexpr (!IsWrite)
+		{
+			std::memcpy(vm::base(buf + static_cast<u32>(result)), bounce, ndone);
+		}
+
+		result += ndone;
+
+		if (ndone < block)
 		{
 			break;
 		}
 	}
 
+	(IsWrite ? stats.write : stats.read).add(result, start);
 	return result;
 }
 
+u64 lv2_file::op_read(const fs::file& file, vm::ptr<void> buf, u64 size)
+{
+	return fs_guest_op<false>(buf.addr(), size, [&](void* ptr, u64, u64 count)
+	{
+		return file.read(ptr, count);
+	});
+}
+
+u64 lv2_file::op_write(const fs::file& file, vm::cptr<void> buf, u64 size)
+{
+	return fs_guest_op<true>(buf.addr(), size, [&](void* ptr, u64, u64 count)
+	{
+		return file.write(ptr, count);
+	});
+}
+
+u64 lv2_file::op_read_at(const fs::file& file, u64 offset, vm::ptr<void> buf, u64 size)
+{
+	return fs_guest_op<false>(buf.addr(), size, [&](void* ptr, u64 done, u64 count)
+	{
+		return file.read_at(offset + done, ptr, count);
+	});
+}
+
+u64 lv2_file::op_write_at(const fs::file& file, u64 offset, vm::cptr<void> buf, u64 size)
+{
+	return fs_guest_op<true>(buf.addr(), size, [&](void* ptr, u64 done, u64 count)
+	{
+		return file.write_at(offset + done, ptr, count);
+	});
+}
+
 struct lv2_file::file_view : fs::file_base
 {
 	const std::shared_ptr<lv2_file> m_file;
@@ -865,7 +953,8 @@ error_code sys_fs_close(ppu_thread& ppu, u32 fd)
 			sys_fs.warning("%s: %s", FD_state_log, *file);
 		}
 
-		// Ensure Host file handle won't be kept open after this syscall
+		// Ensure Host file handle won't be kept open after this syscall (wait for positional accesses)
+		std::lock_guard io_lock(file->io_mutex);
 		file->file.close();
 	}
 
@@ -887,6 +976,16 @@ error_code sys_fs_close(ppu_thread& ppu, u32 fd)
 	return CELL_OK;
 }
 
+// Directory listings of unchanged host directories (keyed by host path and mount points)
+struct lv2_dir_cache
+{
+	static constexpr usz max_size = 512;
+
+	shared_mutex mutex;
+
+	std::unordered_map<std::string, std::pair<s64, std::shared_ptr<const lv2_dir_snapshot>>> map;
+};
+
 error_code sys_fs_opendir(ppu_thread& ppu, vm::cptr<char> path, vm::ptr<u32> fd)
 {
 	ppu.state += cpu_flag::wait;
@@ -923,86 +1022,131 @@ error_code sys_fs_opendir(ppu_thread& ppu, vm::cptr<char> path, vm::ptr<u32> fd)
 
 	std::lock_guard lock(mp->mutex);
 
-	const fs::dir dir(local_path);
+	auto& cache = g_fxo->get<lv2_dir_cache>();
+
+	// Directory mtime changes whenever entries are added, removed or renamed
+	fs::stat_t dir_stat{};
+	const bool has_stat = fs::stat(local_path, dir_stat) && dir_stat.is_directory;
+
+	// Unique key for the host directory and the set of mount points inside it
+	std::string cache_key = local_path;
 
-	if (!dir)
+	for (const auto& ex : ext)
 	{
-		switch (const auto error = fs::g_tls_error)
-		{
-		case fs::error::noent:
-		{
-			if (ext.empty())
-			{
-				return {CELL_ENOENT, path};
-			}
+		cache_key += '\0';
+		cache_key += ex;
+	}
 
-			break;
-		}
-		default:
+	std::shared_ptr<const lv2_dir_snapshot> snapshot;
+
+	if (has_stat)
+	{
+		reader_lock cache_lock(cache.mutex);
+
+		if (const auto found = cache.map.find(cache_key); found != cache.map.end() && found->second.first == dir_stat.mtime)
 		{
-			sys_fs.error("sys_fs_opendir(): unknown error %s", error);
-			return {CELL_EIO, path};
-		}
+			snapshot = found->second.second;
 		}
 	}
 
-	// Build directory as a vector of entries
-	std::vector<fs::dir_entry> data;
-
-	if (dir)
+	if (!snapshot)
 	{
-		// Add real directories
-		while (dir.read(data.emplace_back()))
+		const fs::dir dir(local_path);
+
+		if (!dir)
 		{
-			// Preprocess entries
-			data.back().name = vfs::unescape(data.back().name);
+			switch (const auto error = fs::g_tls_error)
+			{
+			case fs::error::noent:
+			{
+				if (ext.empty())
+				{
+					return {CELL_ENOENT, path};
+				}
 
-			if (!data.back().is_directory && data.back().name == "."sv)
+				break;
+			}
+			default:
 			{
-				// Files hidden from emulation
-				data.resize(data.size() - 1);
-				continue;
+				sys_fs.error("sys_fs_opendir(): unknown error %s", error);
+				return {CELL_EIO, path};
+			}
 			}
+		}
+
+		// Build directory as a vector of entries
+		auto result = std::make_shared<lv2_dir_snapshot>();
+		result->host_path = local_path + '/';
 
-			// Add additional entries for split file candidates (while ends with .66600)
-			while (data.back().name.ends_with(".66600"))
+		auto& data = result->entries;
+
+		if (dir)
+		{
+			// Add real directories
+			for (fs::dir_entry entry; dir.read(entry);)
 			{
-				data.emplace_back(data.back()).name.resize(data.back().name.size() - 6);
+				// Preprocess entries
+				std::string name = vfs::unescape(entry.name);
+
+				if (!entry.is_directory && name == "."sv)
+				{
+					// Files hidden from emulation
+					continue;
+				}
+
+				data.push_back({std::move(name), std::move(entry.name), entry.is_directory});
+
+				// Add additional entries for split file candidates (while ends with .66600)
+				while (data.back().name.ends_with(".66600"))
+				{
+					data.emplace_back(data.back()).name.resize(data.back().name.size() - 6);
+				}
 			}
 		}
+		else
+		{
+			data.push_back({".", {}, true});
+			data.push_back({"..", {}, true});
+		}
 
-		data.resize(data.size() - 1);
-	}
-	else
-	{
-		data.emplace_back().name = ".";
-		data.back().is_directory = true;
-		data.emplace_back().name = "..";
-		data.back().is_directory = true;
-	}
+		// Add mount points (TODO)
+		for (auto&& ex : ext)
+		{
+			data.push_back({ex, {}, true});
+		}
 
-	// Add mount points (TODO)
-	for (auto&& ex : ext)
-	{
-		data.emplace_back().name = std::move(ex);
-		data.back().is_directory = true;
-	}
+		// Sort files, keeping . and ..
+		std::stable_sort(data.begin() + 2, data.end(), [](const lv2_dir_snapshot::entry& a, const lv2_dir_snapshot::entry& b)
+		{
+			return a.name < b.name;
+		});
 
-	// Sort files, keeping . and ..
-	std::stable_sort(data.begin() + 2, data.end(), [](const fs::dir_entry& a, const fs::dir_entry& b)
-	{
-		return a.name < b.name;
-	});
+		// Remove duplicates
+		const auto last = std::unique(data.begin(), data.end(), [](const lv2_dir_snapshot::entry& a, const lv2_dir_snapshot::entry& b)
+		{
+			return a.name == b.name;
+		});
 
-	// Remove duplicates
-	const auto last = std::unique(data.begin(), data.end(), [](const fs::dir_entry& a, const fs::dir_entry& b)
-	{
-		return a.name == b.name;
-	});
+		data.erase(last, data.end());
+		data.shrink_to_fit();
+
+		snapshot = result;
 
-	data.erase(last, data.end());
+		// Don't cache directories modified very recently, mtime resolution may hide further changes
+		if (has_stat && dir_stat.mtime + 2 < static_cast<s64>(std::time(nullptr)))
+		{
+			std::lock_guard cache_lock(cache.mutex);
+
+			if (cache.map.size() >= lv2_dir_cache::max_size)
+			{
+				cache.map.clear();
+			}
 
-	if (const u32 id = idm::make<lv2_fs_object, lv2_dir>(processed_path, std::move(data)))
+			cache.map.insert_or_assign(std::move(cache_key), std::make_pair(dir_stat.mtime, std::move(result)));
+		}
+	}
+
+	if (const u32 id = idm::make<lv2_fs_object, lv2_dir>(processed_path, std::move(snapshot)))
 	{
 		*fd = id;
 		return CELL_OK;
@@ -1934,10 +2078,13 @@ error_code sys_fs_fcntl(ppu_thread& ppu, u32 fd, u32 op, vm::ptr<void> _arg, u32
 		{
 			std::memset(arg->ptr.get_ptr(), 0, arg->max * arg->ptr.size());
 
-			if (auto* info = directory->dir_read())
+			if (auto* dir_entry = directory->dir_read())
 			{
 				auto& entry = arg->ptr[arg->_size++];
 
+				const fs::stat_t stat = directory->get_stat(*dir_entry);
+				const auto info = &stat;
+
 				entry.attribute.mode = info->is_directory ? CELL_FS_S_IFDIR | 0777 : CELL_FS_S_IFREG | 0666;
 				entry.attribute.uid = directory->mp->flags & lv2_mp_flag::no_uid_gid ? -1 : 0;
 				entry.attribute.gid = directory->mp->flags & lv2_mp_flag::no_uid_gid ? -1 : 0;
@@ -1953,9 +2100,9 @@ error_code sys_fs_fcntl(ppu_thread& ppu, u32 fd, u32 op, vm::ptr<void> _arg, u32
 					entry.attribute.mode &= ~0222;
 				}
 
-				entry.entry_name.d_type = info->is_directory ? CELL_FS_TYPE_DIRECTORY : CELL_FS_TYPE_REGULAR;
-				entry.entry_name.d_namlen = u8(std::min<usz>(info->name.size(), CELL_FS_MAX_FS_FILE_NAME_LENGTH));
-				strcpy_trunc(entry.entry_name.d_name, info->name);
+				entry.entry_name.d_type = dir_entry->is_directory ? CELL_FS_TYPE_DIRECTORY : CELL_FS_TYPE_REGULAR;
+				entry.entry_name.d_namlen = u8(std::min<usz>(dir_entry->name.size(), CELL_FS_MAX_FS_FILE_NAME_LENGTH));
+				strcpy_trunc(entry.entry_name.d_name, dir_entry->name);
 			}
 		}
 
@@ -3,6 +3,7 @@
 #include "Emu/Memory/vm_ptr.h"
 #include "Emu/Cell/ErrorCodes.h"
 #include "Utilities/File.h"
+#include "Utilities/mutex.h"
 
 #include <string>
 #include <mutex>
@@ -206,6 +207,9 @@ struct lv2_file final : lv2_fs_object
 	// Stream lock
 	atomic_t<u32> lock{0};
 
+	// Shared by positional accesses (op_read_at, op_write_at) which don't take the mount point mutex, exclusive on close
+	shared_mutex io_mutex;
+
 	// Some variables for convinience of data restoration
 	struct save_restore_t
 	{
@@ -269,6 +273,10 @@ struct lv2_file final : lv2_fs_object
 		return op_write(file, buf, size);
 	}
 
+	// Positional file access (doesn't use the file position, returns umax if the file doesn't support it)
+	static u64 op_read_at(const fs::file& file, u64 offset, vm::ptr<void> buf, u64 size);
+	static u64 op_write_at(const fs::file& file, u64 offset, vm::cptr<void> buf, u64 size);
+
 	// For MSELF support
 	struct file_view;
 
@@ -276,21 +284,43 @@ struct lv2_file final : lv2_fs_object
 	static fs::file make_view(const std::shared_ptr<lv2_file>& _file, u64 offset);
 };
 
+// Immutable directory listing, shared between lv2_dir instances opened on the same unchanged directory
+struct lv2_dir_snapshot
+{
+	struct entry
+	{
+		std::string name;
+
+		// Host name of the entry to get stat info from (empty if none)
+		std::string host_name;
+
+		bool is_directory;
+	};
+
+	// Host directory path (with trailing delimiter)
+	std::string host_path;
+
+	std::vector<entry> entries;
+};
+
 struct lv2_dir final : lv2_fs_object
 {
-	const std::vector<fs::dir_entry> entries;
+	const std::shared_ptr<const lv2_dir_snapshot> snapshot;
+
+	const std::vector<lv2_dir_snapshot::entry>& entries;
 
 	// Current reading position
 	atomic_t<u64> pos{0};
 
-	lv2_dir(std::string_view filename, std::vector<fs::dir_entry>&& entries)
+	lv2_dir(std::string_view filename, std::shared_ptr<const lv2_dir_snapshot> snapshot)
 		: lv2_fs_object(lv2_fs_object::get_mp(filename), filename)
-		, entries(std::move(entries))
+		, snapshot(std::move(snapshot))
+		, entries(this->snapshot->entries)
 	{
 	}
 
 	// Read next
-	const fs::dir_entry* dir_read()
+	const lv2_dir_snapshot::entry* dir_read()
 	{
 		if (const u64 cur = pos++; cur < entries.size())
 		{
@@ -299,6 +329,22 @@ struct lv2_dir final : lv2_fs_object
 
 		return nullptr;
 	}
+
+	// Get stat info of the entry (lazily, zero-filled if not available)
+	fs::stat_t get_stat(const lv2_dir_snapshot::entry& entry) const
+	{
+		fs::stat_t info{};
+
+		if (!entry.host_name.empty() && fs::stat(snapshot->host_path + entry.host_name, info))
+		{
+			info.is_directory = entry.is_directory;
+			return info;
+		}
+
+		info = {};
+		info.is_directory = entry.is_directory;
+		return info;
+	}
 };
 
 // sys_fs_fcntl arg base class (left empty for PODness)
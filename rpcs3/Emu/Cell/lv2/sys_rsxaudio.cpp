@@ -2,6 +2,7 @@
 #include "Emu/Memory/vm.h"
 #include "Emu/IdManager.h"
 #include "Emu/System.h"
+#include "Emu/perf_meter.hpp"
 
 #include "sys_process.h"
 #include "sys_rsxaudio.h"
@@ -14,6 +15,7 @@
 #include <sys/epoll.h>
 #include <sys/timerfd.h>
 #include <sys/eventfd.h>
+#include <sys/prctl.h>
 #include <unistd.h>
 #elif defined(BSD) || defined(__APPLE__)
 #include <unistd.h>
@@ -740,6 +742,11 @@ void rsxaudio_data_thread::operator()()
 {
 	thread_ctrl::scoped_priority high_prio(+1);
 
+#ifdef __linux__
+	// Periods are a few ms long, don't let the kernel coalesce the wakeup (default slack is 50us)
+	prctl(PR_SET_TIMERSLACK, 1, 0, 0, 0);
+#endif
+
 	while (thread_ctrl::state() != thread_state::aborting)
 	{
 		static const std::function<void()> tmr_callback = [this]() { extract_audio_data(); };
@@ -760,6 +767,13 @@ void rsxaudio_data_thread::operator()()
 		}
 		}
 	}
+
+	if (const auto& stats = timer.get_stats(); stats.wakeups)
+	{
+		perf_log.notice("RSXAudio timer: wakeups: %u, late: %u, avg delay: %uus, max delay: %uus, dropped periods: %u",
+			stats.wakeups, stats.late_wakeups, stats.total_delay / stats.wakeups, stats.max_delay, stats.dropped_periods);
+		perf_log.notice("RSXAudio timer: catch-up periods: %u, resyncs: %u", catch_up_periods, resync_count);
+	}
 }
 
 rsxaudio_data_thread& rsxaudio_data_thread::operator=(thread_state /* state */)
@@ -831,6 +845,7 @@ void rsxaudio_data_thread::extract_audio_data()
 
 		if (reset_periods)
 		{
+			resync_count++;
 			timer.vtimer_skip_periods(dst_raw, crnt_time);
 		}
 		else
@@ -839,19 +854,38 @@ void rsxaudio_data_thread::extract_audio_data()
 		}
 	};
 
-	if (timer.is_vtimer_behind(static_cast<u32>(RsxaudioPort::SERIAL), crnt_time))
+	// If the thread woke up late, process all due periods at once instead of going through the timer for each one
+	for (u64 period = 0; period < rsxaudio_periodic_tmr::MAX_BURST_PERIODS; period++)
 	{
-		process_rb(RsxaudioPort::SERIAL, hw_cfg->serial.dma_en);
-	}
+		bool processed = false;
 
-	if (timer.is_vtimer_behind(static_cast<u32>(RsxaudioPort::SPDIF_0), crnt_time))
-	{
-		process_rb(RsxaudioPort::SPDIF_0, hw_cfg->spdif[0].dma_en);
-	}
+		if (timer.is_vtimer_behind(static_cast<u32>(RsxaudioPort::SERIAL), crnt_time))
+		{
+			process_rb(RsxaudioPort::SERIAL, hw_cfg->serial.dma_en);
+			processed = true;
+		}
 
-	if (timer.is_vtimer_behind(static_cast<u32>(RsxaudioPort::SPDIF_1), crnt_time))
-	{
-		process_rb(RsxaudioPort::SPDIF_1, hw_cfg->spdif[1].dma_en);
+		if (timer.is_vtimer_behind(static_cast<u32>(RsxaudioPort::SPDIF_0), crnt_time))
+		{
+			process_rb(RsxaudioPort::SPDIF_0, hw_cfg->spdif[0].dma_en);
+			processed = true;
+		}
+
+		if (timer.is_vtimer_behind(static_cast<u32>(RsxaudioPort::SPDIF_1), crnt_time))
+		{
+			process_rb(RsxaudioPort::SPDIF_1, hw_cfg->spdif[1].dma_en);
+			processed = true;
+		}
+
+		if (!processed)
+		{
+			break;
+		}
+
+		if (period)
+		{
+			catch_up_periods++;
+		}
 	}
 }
 
@@ -1892,7 +1926,8 @@ void rsxaudio_backend_thread::reset_service_time()
 
 void rsxaudio_periodic_tmr::sched_timer()
 {
-	u64 interval = get_rel_next_time();
+	const u64 crnt_time = get_system_time();
+	u64 interval = get_rel_next_time(crnt_time);
 
 	if (interval == 0)
 	{
@@ -1906,6 +1941,7 @@ void rsxaudio_periodic_tmr::sched_timer()
 	else
 	{
 		zero_period = false;
+		deadline = crnt_time + interval;
 	}
 
 #if defined(_WIN32)
@@ -1993,7 +2029,15 @@ rsxaudio_periodic_tmr::rsxaudio_periodic_tmr()
 {
 #if defined(_WIN32)
 	ensure(cancel_event = CreateEvent(nullptr, false, false, nullptr));
-	ensure(timer_handle = CreateWaitableTimer(nullptr, false, nullptr));
+
+	// Regular waitable timers are bound to the system tick (up to 15.6ms), high resolution ones need Windows 10 1803
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+	static constexpr DWORD CREATE_WAITABLE_TIMER_HIGH_RESOLUTION = 0x00000002;
+#endif
+	if (!(timer_handle = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS)))
+	{
+		ensure(timer_handle = CreateWaitableTimer(nullptr, false, nullptr));
+	}
 #elif defined(__linux__)
 	timer_handle = timerfd_create(CLOCK_MONOTONIC, 0);
 	ensure((epoll_fd = epoll_create(2)) >= 0);
@@ -2048,6 +2092,7 @@ rsxaudio_periodic_tmr::wait_result rsxaudio_periodic_tmr::wait(const std::functi
 
 	in_wait = true;
 
+	const bool timer_wait = !zero_period;
 	bool tmr_error     = false;
 	bool timeout       = false;
 	bool wait_canceled = false;
@@ -2161,15 +2206,25 @@ rsxaudio_periodic_tmr::wait_result rsxaudio_periodic_tmr::wait(const std::functi
 	}
 	else
 	{
+		if (timer_wait)
+		{
+			const u64 crnt_time = get_system_time();
+			const u64 delay = crnt_time > deadline ? crnt_time - deadline : 0;
+
+			stats.wakeups++;
+			stats.late_wakeups += delay >= LATE_WAKEUP_THRESHOLD;
+			stats.total_delay += delay;
+			stats.max_delay = std::max(stats.max_delay, delay);
+		}
+
 		callback();
 		sched_timer();
 		return wait_result::SUCCESS;
 	}
 }
 
-u64 rsxaudio_periodic_tmr::get_rel_next_time()
+u64 rsxaudio_periodic_tmr::get_rel_next_time(u64 crnt_time)
 {
-	const u64 crnt_time = get_system_time();
 	u64 next_time = UINT64_MAX;
 
 	for (vtimer& vtimer : vtmr_pool)
@@ -2184,6 +2239,7 @@ u64 rsxaudio_periodic_tmr::get_rel_next_time()
 
 			if (crnt_blk > vtimer.blk_cnt + MAX_BURST_PERIODS)
 			{
+				stats.dropped_periods += crnt_blk - MAX_BURST_PERIODS - vtimer.blk_cnt;
 				vtimer.blk_cnt = std::max(vtimer.blk_cnt, crnt_blk - MAX_BURST_PERIODS);
 				next_blk_time = static_cast<u64>(vtimer.blk_cnt * vtimer.blk_time);
 			}
@@ -198,6 +198,15 @@ public:
 		TIMER_CANCELED,
 	};
 
+	struct stats_t
+	{
+		u64 wakeups = 0;         // Timer expirations
+		u64 late_wakeups = 0;    // Expirations later than LATE_WAKEUP_THRESHOLD
+		u64 total_delay = 0;     // Sum of expiration delays (us)
+		u64 max_delay = 0;       // Worst expiration delay (us)
+		u64 dropped_periods = 0; // Periods skipped because the timer fell more than MAX_BURST_PERIODS behind
+	};
+
 	rsxaudio_periodic_tmr();
 	~rsxaudio_periodic_tmr();
 
@@ -236,9 +245,14 @@ public:
 
 	u64 vtimer_get_sched_time(u32 vtimer_id) const;
 
-private:
+	// Only safe to call from the waiting thread
+	const stats_t& get_stats() const { return stats; }
 
 	static constexpr u64 MAX_BURST_PERIODS = SYS_RSXAUDIO_RINGBUF_SZ;
+
+private:
+
+	static constexpr u64 LATE_WAKEUP_THRESHOLD = 1'000;
 	static constexpr u32 VTIMER_MAX = 4;
 
 	struct vtimer
@@ -254,6 +268,9 @@ private:
 	bool in_wait = false;
 	bool zero_period = false;
 
+	u64 deadline = 0; // Absolute expiration time set by sched_timer()
+	stats_t stats{};
+
 #if defined(_WIN32)
 	HANDLE cancel_event{};
 	HANDLE timer_handle{};
@@ -280,7 +297,7 @@ private:
 	u64 get_crnt_blk(u64 crnt_time, f64 blk_time) const;
 	f64 get_blk_time(u32 data_rate) const;
 
-	u64 get_rel_next_time();
+	u64 get_rel_next_time(u64 crnt_time);
 };
 
 struct rsxaudio_hw_param_t
@@ -600,6 +617,9 @@ private:
 	transactional_storage<rsxaudio_hw_param_t> hw_param_ts{std::make_shared<universal_pool>(), std::make_shared<rsxaudio_hw_param_t>()};
 	rsxaudio_periodic_tmr timer{};
 
+	u64 catch_up_periods = 0; // Periods processed late, in the same wakeup as an earlier one
+	u64 resync_count = 0;     // Period skips after the data couldn't be delivered in time
+
 	void advance_all_timers();
 	void extract_audio_data();
 	static std::pair<bool /*data_present*/, void* /*addr*/> get_ringbuf_addr(RsxaudioPort dst, const lv2_rsxaudio& rsxaudio_obj);
@@ -25,6 +25,8 @@
 
 LOG_CHANNEL(sys_spu);
 
+extern void spursKernelPatchHle(spu_thread& spu, u32 entry, u32 group_id);
+
 template <>
 void fmt_class_string<spu_group_status>::format(std::string& out, u64 arg)
 {
@@ -266,6 +268,67 @@ struct spu_limits_t
 	}
 };
 
+// Assigns SPU thread groups to host cache domains so that threads exchanging data through reservations share a cache
+struct spu_placement_t
+{
+	shared_mutex mutex;
+	std::vector<u32> load; // Number of SPU threads placed on each domain
+
+	void place(lv2_spu_group& group)
+	{
+		std::lock_guard lock(mutex);
+
+		if (group.cache_domain >= 0)
+		{
+			return;
+		}
+
+		const auto& domains = thread_ctrl::get_cache_domains();
+
+		if (domains.size() <= 1)
+		{
+			// Nothing to choose from
+			return;
+		}
+
+		load.resize(domains.size());
+
+		// Pick the least loaded domain, prefer the earlier one on tie
+		const usz index = std::min_element(load.begin(), load.end()) - load.begin();
+
+		load[index] += group.max_num;
+		group.cache_domain = static_cast<s32>(index);
+		group.affinity_mask = domains[index];
+
+		sys_spu.notice("SPU Thread Group '%s' (0x%x) placed on cache domain %u (mask=0x%x, load=%u)", group.name, group.id, index, domains[index], load[index]);
+	}
+
+	void release(lv2_spu_group& group)
+	{
+		std::lock_guard lock(mutex);
+
+		if (group.cache_domain < 0)
+		{
+			return;
+		}
+
+		load[group.cache_domain] -= group.max_num;
+		group.cache_domain = -1;
+		group.affinity_mask = 0;
+	}
+};
+
+// Undo the pinning done by sys_spu_thread_group_start on the calling PPU thread
+void restore_ppu_affinity(ppu_thread& ppu, u32 group_id)
+{
+	if (ppu.spu_affinity_group && ppu.spu_affinity_group == group_id)
+	{
+		thread_ctrl::set_thread_affinity_mask(ppu.spu_affinity_restore);
+		ppu.spu_affinity_group = 0;
+		ppu.spu_affinity_restore = 0;
+	}
+}
+
 } // annonymous namespace
 
 error_code sys_spu_initialize(ppu_thread& ppu, u32 max_usable_spu, u32 max_raw_spu)
@@ -837,7 +900,13 @@ error_code sys_spu_thread_group_destroy(ppu_thread& ppu, u32 id)
 		return group.ret;
 	}
 
-	group->mutex.lock_unlock();
+	{
+		// Placement data is read by observers under the group lock
+		std::lock_guard lock(group->mutex);
+		g_fxo->get<spu_placement_t>().release(*group);
+	}
+
+	restore_ppu_affinity(ppu, id);
 
 	for (const auto& t : group->threads)
 	{
@@ -879,6 +948,24 @@ error_code sys_spu_thread_group_start(ppu_thread& ppu, u32 id)
 
 	const u32 max_threads = group->max_run;
 
+	if (g_cfg.core.spu_group_affinity)
+	{
+		g_fxo->get<spu_placement_t>().place(*group);
+
+		if (const u64 mask = group->affinity_mask)
+		{
+			if (!ppu.spu_affinity_group)
+			{
+				// Remember the scheduler-assigned mask, restored when the group stops
+				ppu.spu_affinity_restore = thread_ctrl::get_thread_affinity_mask();
+			}
+
+			// Keep the owner PPU thread close to its SPUs while the group runs
+			ppu.spu_affinity_group = id;
+			thread_ctrl::set_thread_affinity_mask(mask);
+		}
+	}
+
 	group->join_state = 0;
 	group->exit_status = 0;
 	group->running = max_threads;
@@ -899,6 +986,8 @@ error_code sys_spu_thread_group_start(ppu_thread& ppu, u32 id)
 			thread->gpr[5] = v128::from64(0, args[2]);
 			thread->gpr[6] = v128::from64(0, args[3]);
 
+			spursKernelPatchHle(*thread, img.first, id);
+
 			thread->status_npc = {SPU_STATUS_RUNNING, img.first};
 		}
 	}
@@ -1167,6 +1256,7 @@ error_code sys_spu_thread_group_terminate(ppu_thread& ppu, u32 id, s32 value)
 			group->stop_count.wait(last_stop);
 		}
 
+		restore_ppu_affinity(ppu, id);
 		return CELL_ESTAT;
 	}
 
@@ -1211,6 +1301,7 @@ error_code sys_spu_thread_group_terminate(ppu_thread& ppu, u32 id, s32 value)
 		group->stop_count.wait(last_stop);
 	}
 
+	restore_ppu_affinity(ppu, id);
 	return CELL_OK;
 }
 
@@ -1280,6 +1371,8 @@ error_code sys_spu_thread_group_join(ppu_thread& ppu, u32 id, vm::ptr<u32> cause
 	}
 	while (false);
 
+	restore_ppu_affinity(ppu, id);
+
 	if (!cause)
 	{
 		if (status)
@@ -285,6 +285,8 @@ struct lv2_spu_group
 	atomic_t<u32> join_state; // flags used to detect exit cause and signal
 	atomic_t<u32> running; // Number of running threads
 	atomic_t<u64> stop_count;
+	atomic_t<u64> affinity_mask{0}; // Host cache domain assigned by the placement policy (0 = unrestricted)
+	s32 cache_domain = -1; // Index of the assigned host cache domain (written under both the group mutex and spu_placement_t::mutex)
 	class ppu_thread* waiter = nullptr;
 	bool set_terminate = false;
 
@@ -1,5 +1,9 @@
 #include "stdafx.h"
 #include "VKCommonDecompiler.h"
+#include "Emu/system_config.h"
+#include "Emu/cache_utils.hpp"
+
+#include "xxhash.h"
 
 #ifdef _MSC_VER
 #pragma warning(push, 0)
@@ -25,6 +29,79 @@ namespace vk
 {
 	static TBuiltInResource g_default_config;
 
+	// On-disk SPIR-V cache, keyed by the GLSL source and the glslang build. Bump the version when the glslang setup in compile_glsl_to_spv changes.
+	static constexpr u32 spirv_cache_version = 2;
+
+	struct spirv_cache_header
+	{
+		u32 magic = "SPVC"_u32;
+		u32 version = spirv_cache_version;
+		u64 compiler_hash = 0; // glslang version, entries from another build are recompiled
+		u64 source_size = 0;
+		u64 source_hash = 0; // Second hash of the source with a different seed, guards against file name collisions
+
+		bool operator==(const spirv_cache_header&) const = default;
+	};
+
+	// Set up by initialize_compiler_context before any compilation, empty when the cache is disabled
+	static std::string g_spirv_cache_dir;
+	static u64 g_spirv_compiler_hash = 0;
+
+	static atomic_t<u32> g_spirv_cache_hits = 0;
+	static atomic_t<u32> g_spirv_cache_misses = 0;
+
+	static std::string get_spirv_cache_path(u64 key)
+	{
+		return fmt::format("%s%016llx.spv", g_spirv_cache_dir, key);
+	}
+
+	static bool load_cached_spv(const std::string& path, const spirv_cache_header& expected, std::vector<u32>& spv)
+	{
+		fs::file f(path);
+		spirv_cache_header header{};
+
+		if (!f || !f.read(header) || header != expected)
+		{
+			return false;
+		}
+
+		const u64 size = f.size() - sizeof(header);
+
+		if (!size || size % sizeof(u32) || size > 0x100'0000)
+		{
+			return false;
+		}
+
+		std::vector<u32> result(size / sizeof(u32));
+
+		if (f.read(result.data(), size) != size || result[0] != 0x07230203) // SPIR-V magic
+		{
+			return false;
+		}
+
+		spv = std::move(result);
+		return true;
+	}
+
+	static void store_cached_spv(const std::string& path, const spirv_cache_header& header, const std::vector<u32>& spv)
+	{
+		// Written to a temporary file first, a concurrent reader never sees a partial blob
+		fs::pending_file temp(path);
+
+		if (!temp.file)
+		{
+			return;
+		}
+
+		temp.file.write(header);
+		temp.file.write(spv);
+
+		if (!temp.commit())
+		{
+			rsx_log.warning("Failed to write SPIR-V cache entry %s (%s)", path, fs::g_tls_error);
+		}
+	}
+
 	void init_default_resources(TBuiltInResource &rsc)
 	{
 		rsc.maxLights = 32;
@@ -157,6 +234,27 @@ namespace vk
 
 	bool compile_glsl_to_spv(std::string& shader, program_domain domain, std::vector<u32>& spv)
 	{
+		const bool use_cache = !g_spirv_cache_dir.empty();
+		std::string cache_path;
+		spirv_cache_header cache_header{};
+
+		if (use_cache)
+		{
+			const u64 key = XXH64(shader.data(), shader.size(), g_spirv_compiler_hash ^ ((u64{spirv_cache_version} << 8) | domain));
+			cache_path = get_spirv_cache_path(key);
+			cache_header.compiler_hash = g_spirv_compiler_hash;
+			cache_header.source_size = shader.size();
+			cache_header.source_hash = XXH64(shader.data(), shader.size(), ~key);
+
+			if (load_cached_spv(cache_path, cache_header, spv))
+			{
+				g_spirv_cache_hits++;
+				return true;
+			}
+
+			g_spirv_cache_misses++;
+		}
+
 		EShLanguage lang = (domain == glsl_fragment_program) ? EShLangFragment :
 			(domain == glsl_vertex_program)? EShLangVertex : EShLangCompute;
 
@@ -198,6 +296,11 @@ namespace vk
 			rsx_log.error("%s", shader_object.getInfoDebugLog());
 		}
 
+		if (success && use_cache && !spv.empty())
+		{
+			store_cached_spv(cache_path, cache_header, spv);
+		}
+
 		return success;
 	}
 
@@ -205,10 +308,36 @@ namespace vk
 	{
 		glslang::InitializeProcess();
 		init_default_resources(g_default_config);
+
+		g_spirv_cache_dir.clear();
+
+		if (!g_cfg.video.disable_on_disk_shader_cache)
+		{
+			// Per title, next to the RSX shader archive
+			if (const std::string cache_path = rpcs3::cache::get_ppu_cache(); !cache_path.empty())
+			{
+				g_spirv_cache_dir = cache_path + "shaders_cache/spirv/";
+
+				if (!fs::create_path(g_spirv_cache_dir))
+				{
+					rsx_log.error("Failed to create SPIR-V cache directory %s (%s)", g_spirv_cache_dir, fs::g_tls_error);
+					g_spirv_cache_dir.clear();
+				}
+			}
+		}
+
+		const std::string_view glslang_version = glslang::GetGlslVersionString();
+		g_spirv_compiler_hash = XXH64(glslang_version.data(), glslang_version.size(), glslang::GetSpirvGeneratorVersion());
 	}
 
 	void finalize_compiler_context()
 	{
+		if (const u32 hits = g_spirv_cache_hits.exchange(0), misses = g_spirv_cache_misses.exchange(0); hits || misses)
+		{
+			rsx_log.notice("SPIR-V cache: %u hits, %u misses", hits, misses);
+		}
+
+		g_spirv_cache_dir.clear();
 		glslang::FinalizeProcess();
 	}
 }
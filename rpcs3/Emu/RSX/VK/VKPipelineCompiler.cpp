@@ -3,6 +3,8 @@
 #include "VKRenderPass.h"
 #include "vkutils/device.h"
 #include "Utilities/Thread.h"
+#include "Emu/cache_utils.hpp"
+#include "../Common/time.hpp"
 
 #include <thread>
 
@@ -15,6 +17,146 @@ namespace vk
 	int g_num_pipe_compilers = 0;
 	atomic_t<int> g_compiler_index{};
 
+	// Driver side pipeline cache shared by all workers (VkPipelineCache is internally synchronized)
+	VkPipelineCache g_pipeline_cache = VK_NULL_HANDLE;
+	std::string g_pipeline_cache_path;
+	usz g_pipeline_cache_loaded_size = 0;
+
+	// Pipeline creation stats, compare a boot with a cold and a warm cache to see what the driver cache saves
+	atomic_t<u32> g_pipelines_created{};
+	atomic_t<u64> g_pipeline_creation_time{};
+
+	static std::string get_pipeline_cache_path(const VkPhysicalDeviceProperties& props)
+	{
+		if (g_cfg.video.disable_on_disk_shader_cache)
+		{
+			return {};
+		}
+
+		const std::string cache_path = rpcs3::cache::get_ppu_cache();
+
+		if (cache_path.empty())
+		{
+			return {};
+		}
+
+		std::string uuid;
+
+		for (u8 c : props.pipelineCacheUUID)
+		{
+			fmt::append(uuid, "%02x", c);
+		}
+
+		// Next to the RSX pipeline archive, one file per device and driver build
+		const std::string dir = cache_path + "shaders_cache/pipelines/vulkan/";
+		fs::create_path(dir);
+
+		return fmt::format("%sdriver_%04x_%04x_%s.bin", dir, props.vendorID, props.deviceID, uuid);
+	}
+
+	static void create_pipeline_cache(const vk::render_device& dev)
+	{
+		const auto& props = dev.gpu().get_properties();
+
+		g_pipeline_cache_path = get_pipeline_cache_path(props);
+		g_pipeline_cache_loaded_size = 0;
+		g_pipelines_created = 0;
+		g_pipeline_creation_time = 0;
+
+		std::vector<u8> data;
+
+		if (fs::file f; !g_pipeline_cache_path.empty() && f.open(g_pipeline_cache_path))
+		{
+			data = f.to_vector<u8>();
+
+			// Not every driver validates the blob, reject data from another device or driver build here
+			VkPipelineCacheHeaderVersionOne header{};
+
+			if (data.size() >= sizeof(header))
+			{
+				std::memcpy(&header, data.data(), sizeof(header));
+			}
+
+			if (data.size() < sizeof(header) ||
+				header.headerSize < sizeof(header) ||
+				header.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE ||
+				header.vendorID != props.vendorID ||
+				header.deviceID != props.deviceID ||
+				std::memcmp(header.pipelineCacheUUID, props.pipelineCacheUUID, VK_UUID_SIZE) != 0)
+			{
+				rsx_log.warning("Discarding incompatible Vulkan pipeline cache '%s'", g_pipeline_cache_path);
+				data.clear();
+			}
+		}
+
+		VkPipelineCacheCreateInfo info = {};
+		info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+		info.initialDataSize = data.size();
+		info.pInitialData = data.empty() ? nullptr : data.data();
+
+		if (vkCreatePipelineCache(dev, &info, nullptr, &g_pipeline_cache) != VK_SUCCESS && !data.empty())
+		{
+			rsx_log.warning("Failed to create the Vulkan pipeline cache from '%s', starting with an empty one", g_pipeline_cache_path);
+
+			data.clear();
+			info.initialDataSize = 0;
+			info.pInitialData = nullptr;
+
+			if (vkCreatePipelineCache(dev, &info, nullptr, &g_pipeline_cache) != VK_SUCCESS)
+			{
+				g_pipeline_cache = VK_NULL_HANDLE;
+			}
+		}
+
+		g_pipeline_cache_loaded_size = data.size();
+
+		if (!data.empty())
+		{
+			rsx_log.notice("Loaded Vulkan pipeline cache (%u KiB)", data.size() / 1024);
+		}
+	}
+
+	static void destroy_pipeline_cache(const vk::render_device& dev)
+	{
+		if (const u32 count = g_pipelines_created)
+		{
+			const u64 time = g_pipeline_creation_time;
+			rsx_log.notice("Vulkan pipeline cache: %u pipelines created in %ums (avg %uus) with a %s cache", count, time / 1000, time / count, g_pipeline_cache_loaded_size ? "warm" : "cold");
+		}
+
+		if (!g_pipeline_cache)
+		{
+			return;
+		}
+
+		usz size = 0;
+
+		// Only write back when the driver added something
+		if (!g_pipeline_cache_path.empty() && g_pipelines_created &&
+			vkGetPipelineCacheData(dev, g_pipeline_cache, &size, nullptr) == VK_SUCCESS && size && size != g_pipeline_cache_loaded_size)
+		{
+			std::vector<u8> data(size);
+
+			if (vkGetPipelineCacheData(dev, g_pipeline_cache, &size, data.data()) == VK_SUCCESS)
+			{
+				data.resize(size);
+
+				if (fs::pending_file temp(g_pipeline_cache_path); temp.file)
+				{
+					temp.file.write(data);
+
+					if (!temp.commit())
+					{
+						rsx_log.error("Failed to save the Vulkan pipeline cache to '%s' (%s)", g_pipeline_cache_path, fs::g_tls_error);
+					}
+				}
+			}
+		}
+
+		vkDestroyPipelineCache(dev, g_pipeline_cache, nullptr);
+		g_pipeline_cache = VK_NULL_HANDLE;
+	}
+
 	pipe_compiler::pipe_compiler()
 	{
 		// TODO: Initialize workqueue
@@ -55,7 +197,11 @@ namespace vk
 	std::unique_ptr<glsl::program> pipe_compiler::int_compile_compute_pipe(const VkComputePipelineCreateInfo& create_info, VkPipelineLayout pipe_layout)
 	{
 		VkPipeline pipeline;
-		vkCreateComputePipelines(*g_render_device, nullptr, 1, &create_info, nullptr, &pipeline);
+		const u64 start = rsx::uclock();
+		vkCreateComputePipelines(*g_render_device, g_pipeline_cache, 1, &create_info, nullptr, &pipeline);
+		g_pipeline_creation_time += rsx::uclock() - start;
+		g_pipelines_created++;
+
 		return std::make_unique<vk::glsl::program>(*m_device, pipeline, pipe_layout);
 	}
 
@@ -63,7 +209,11 @@ namespace vk
 			const std::vector<glsl::program_input>& vs_inputs, const std::vector<glsl::program_input>& fs_inputs)
 	{
 		VkPipeline pipeline;
-		CHECK_RESULT(vkCreateGraphicsPipelines(*m_device, nullptr, 1, &create_info, NULL, &pipeline));
+		const u64 start = rsx::uclock();
+		CHECK_RESULT(vkCreateGraphicsPipelines(*m_device, g_pipeline_cache, 1, &create_info, NULL, &pipeline));
+		g_pipeline_creation_time += rsx::uclock() - start;
+		g_pipelines_created++;
+
 		auto result = std::make_unique<vk::glsl::program>(*m_device, pipeline, pipe_layout, vs_inputs, fs_inputs);
 		result->link();
 		return result;
@@ -235,6 +385,8 @@ namespace vk
 		ensure(num_worker_threads >= 1);
 		ensure(g_render_device); // "Cannot initialize pipe compiler before creating a logical device"
 
+		create_pipeline_cache(*g_render_device);
+
 		// Create the thread pool
 		g_pipe_compilers = std::make_unique<named_thread_group<pipe_compiler>>("RSX.W", num_worker_threads);
 		g_num_pipe_compilers = num_worker_threads;
@@ -249,6 +401,11 @@ namespace vk
 	void destroy_pipe_compiler()
 	{
 		g_pipe_compilers.reset();
+
+		if (g_render_device)
+		{
+			destroy_pipeline_cache(*g_render_device);
+		}
 	}
 
 	pipe_compiler* get_pipe_compiler()
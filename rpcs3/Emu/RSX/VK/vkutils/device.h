@@ -90,6 +90,7 @@ namespace vk
 		const VkQueueFamilyProperties& get_queue_properties(u32 queue);
 		const VkPhysicalDeviceMemoryProperties& get_memory_properties() const;
 		const VkPhysicalDeviceLimits& get_limits() const;
+		const VkPhysicalDeviceProperties& get_properties() const;
 
 		operator VkPhysicalDevice() const;
 		operator VkInstance() const;
@@ -27,6 +27,7 @@
 
 #include "Loader/PSF.h"
 #include "Loader/ELF.h"
+#include "Loader/ISO.h"
 
 #include "Utilities/StrUtil.h"
 
@@ -542,6 +543,21 @@ game_boot_result Emulator::BootGame(const std::string& path, const std::string&
 		return game_boot_result::invalid_file_or_folder;
 	}
 
+	if (!direct && is_iso_file(path))
+	{
+		// Disc image: boot from the root of the mounted image
+		const std::string root = mount_iso(path);
+
+		if (root.empty())
+		{
+			sys_log.error("Failed to mount disc image: %s", path);
+			return game_boot_result::invalid_file_or_folder;
+		}
+
+		m_disc_image = path;
+		return BootGame(root, title_id, false, add_only, config_mode, config_path);
+	}
+
 	m_path_old = m_path;
 
 	m_config_mode = config_mode;
@@ -609,7 +625,8 @@ void Emulator::SetForceBoot(bool force_boot)
 
 game_boot_result Emulator::Load(const std::string& title_id, bool add_only, bool is_disc_patch)
 {
-	const std::string resolved_path = GetCallbacks().resolve_path(m_path);
+	// Paths of virtual devices (mounted disc images) cannot be resolved by the host
+	const std::string resolved_path = fs::get_virtual_device(m_path) ? m_path : GetCallbacks().resolve_path(m_path);
 
 	if (m_config_mode == cfg_mode::continuous)
 	{
@@ -843,6 +860,13 @@ game_boot_result Emulator::Load(const std::string& title_id, bool add_only, bool
 		{
 			bdvd_dir = g_cfg_vfs.dev_bdvd;
 
+			if (is_iso_file(bdvd_dir))
+			{
+				// Custom BDVD disc image
+				m_disc_image = bdvd_dir;
+				bdvd_dir = mount_iso(bdvd_dir);
+			}
+
 			if (!bdvd_dir.empty() && bdvd_dir.back() != fs::delim[0] && bdvd_dir.back() != fs::delim[1])
 			{
 				bdvd_dir.push_back('/');
@@ -1076,6 +1100,17 @@ game_boot_result Emulator::Load(const std::string& title_id, bool add_only, bool
 			if (auto node = games[m_title_id])
 			{
 				bdvd_dir = node.Scalar();
+
+				if (is_iso_file(bdvd_dir))
+				{
+					m_disc_image = bdvd_dir;
+					bdvd_dir = mount_iso(bdvd_dir);
+
+					if (!bdvd_dir.empty())
+					{
+						bdvd_dir.push_back('/');
+					}
+				}
 			}
 			else
 			{
@@ -1119,8 +1154,8 @@ game_boot_result Emulator::Load(const std::string& title_id, bool add_only, bool
 					sys_log.error("Unexpected PARAM.SFO found in disc directory '%s' (found '%s')", m_title_id, bdvd_title_id);
 				}
 
-				// Store /dev_bdvd/ location
-				games[m_title_id] = bdvd_dir;
+				// Store /dev_bdvd/ location (image path instead of the temporary device root)
+				games[m_title_id] = fs::get_virtual_device(bdvd_dir) ? m_disc_image : bdvd_dir;
 				YAML::Emitter out;
 				out << games;
 
@@ -1343,7 +1378,7 @@ game_boot_result Emulator::Load(const std::string& title_id, bool add_only, bool
 			elf_path = vfs::get(argv[0]);
 		}
 
-		fs::file elf_file(elf_path);
+		fs::file elf_file = fs::make_mapped(elf_path);
 
 		if (!elf_file)
 		{
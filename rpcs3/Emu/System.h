@@ -102,6 +102,7 @@ class Emulator final
 	std::string m_config_path;
 	std::string m_path;
 	std::string m_path_old;
+	std::string m_disc_image; // Mounted disc image (ISO) for /dev_bdvd
 	std::string m_title_id;
 	std::string m_title;
 	std::string m_app_version;
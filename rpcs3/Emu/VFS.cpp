@@ -13,6 +13,7 @@
 #endif
 
 #include <thread>
+#include <unordered_map>
 
 LOG_CHANNEL(vfs_log, "VFS");
 
@@ -25,12 +26,41 @@ struct vfs_directory
 	std::vector<std::pair<std::string, vfs_directory>> dirs{};
 };
 
+struct vfs_path_hash
+{
+	using is_transparent = void;
+
+	usz operator()(std::string_view path) const noexcept
+	{
+		return std::hash<std::string_view>{}(path);
+	}
+};
+
 struct vfs_manager
 {
 	shared_mutex mutex{};
 
 	// VFS root
 	vfs_directory root{};
+
+	// Resolved paths (cleared on every mount)
+	shared_mutex cache_mutex{};
+	std::unordered_map<std::string, std::string, vfs_path_hash, std::equal_to<>> cache{};
+
+	static constexpr usz max_cache_size = 8192;
+
+	atomic_t<u64> cache_hits = 0;
+	atomic_t<u64> cache_misses = 0;
+
+	vfs_manager() = default;
+
+	~vfs_manager()
+	{
+		if (const u64 total = cache_hits + cache_misses)
+		{
+			vfs_log.notice("Path cache: %u hits, %u misses (%.1f%% hit rate)", cache_hits, cache_misses, cache_hits * 100. / total);
+		}
+	}
 };
 
 bool vfs::mount(std::string_view vpath, std::string_view path)
@@ -44,6 +74,12 @@ bool vfs::mount(std::string_view vpath, std::string_view path)
 
 	std::lock_guard lock(table.mutex);
 
+	{
+		// Mount table changes invalidate all resolved paths
+		std::lock_guard cache_lock(table.cache_mutex);
+		table.cache.clear();
+	}
+
 	if (vpath.empty())
 	{
 		// Empty relative path, should set relative path base; unsupported
@@ -116,12 +152,8 @@ bool vfs::mount(std::string_view vpath, std::string_view path)
 	}
 }
 
-std::string vfs::get(std::string_view vpath, std::vector<std::string>* out_dir, std::string* out_path)
+static std::string vfs_get_impl(const vfs_manager& table, std::string_view vpath, std::vector<std::string>* out_dir, std::string* out_path)
 {
-	auto& table = g_fxo->get<vfs_manager>();
-
-	reader_lock lock(table.mutex);
-
 	// Resulting path fragments: decoded ones
 	std::vector<std::string_view> result;
 	result.reserve(vpath.size() / 2);
@@ -288,6 +320,51 @@ std::string vfs::get(std::string_view vpath, std::vector<std::string>* out_dir,
 	return std::string{result_base} + fmt::merge(escaped, "/");
 }
 
+std::string vfs::get(std::string_view vpath, std::vector<std::string>* out_dir, std::string* out_path)
+{
+	auto& table = g_fxo->get<vfs_manager>();
+
+	reader_lock lock(table.mutex);
+
+	if (out_dir || out_path)
+	{
+		// Additional output is not cached
+		return vfs_get_impl(table, vpath, out_dir, out_path);
+	}
+
+	{
+		reader_lock cache_lock(table.cache_mutex);
+
+		if (const auto found = table.cache.find(vpath); found != table.cache.end())
+		{
+			table.cache_hits++;
+			return found->second;
+		}
+	}
+
+	std::string result = vfs_get_impl(table, vpath, nullptr, nullptr);
+
+	table.cache_misses++;
+
+	// Insert while holding the mount table lock so a concurrent mount cannot leave stale entries behind
+	std::lock_guard cache_lock(table.cache_mutex);
+
+	if (table.cache.size() >= vfs_manager::max_cache_size)
+	{
+		table.cache.clear();
+	}
+
+	table.cache.emplace(vpath, result);
+	return result;
+}
+
+std::pair<u64, u64> vfs::get_cache_stats()
+{
+	auto& table = g_fxo->get<vfs_manager>();
+
+	return {table.cache_hits.load(), table.cache_misses.load()};
+}
+
 #if __cpp_char8_t >= 201811
 using char2 = char8_t;
 #else
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "util/types.hpp"
+
 #include <vector>
 #include <string>
 #include <string_view>
@@ -14,6 +16,9 @@ namespace vfs
 	// Convert VFS path to fs path, optionally listing directories mounted in it
 	std::string get(std::string_view vpath, std::vector<std::string>* out_dir = nullptr, std::string* out_path = nullptr);
 
+	// Get path resolution cache statistics (hits, misses)
+	std::pair<u64, u64> get_cache_stats();
+
 	// Escape VFS name by replacing non-portable characters with surrogates
 	std::string escape(std::string_view name, bool escape_slash = false);
 
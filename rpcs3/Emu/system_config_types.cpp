@@ -566,6 +566,21 @@ void fmt_class_string<audio_format>::format(std::string& out, u64 arg)
 	});
 }
 
+template <>
+void fmt_class_string<audio_dump_format>::format(std::string& out, u64 arg)
+{
+	format_enum(out, arg, [](audio_dump_format value)
+	{
+		switch (value)
+		{
+		case audio_dump_format::wav: return "WAV";
+		case audio_dump_format::flac: return "FLAC";
+		}
+
+		return unknown;
+	});
+}
+
 template <>
 void fmt_class_string<vk_gpu_scheduler_mode>::format(std::string& out, u64 arg)
 {
@@ -85,6 +85,12 @@ enum class audio_format
 	manual,
 };
 
+enum class audio_dump_format
+{
+	wav,
+	flac,
+};
+
 enum class audio_format_flag : unsigned
 {
 	lpcm_2_48khz   = 0x00000000, // Linear PCM 2 Ch. 48 kHz (always available)
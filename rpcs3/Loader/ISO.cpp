@@ -0,0 +1,663 @@
+#include "stdafx.h"
+
+#include "ISO.h"
+
+#include "Utilities/StrUtil.h"
+
+#include <cstring>
+
+LOG_CHANNEL(iso_log, "ISO");
+
+namespace
+{
+	constexpr u64 iso_sector_size = 2048;
+
+	template <typename T>
+	T read_le(const u8* ptr)
+	{
+		le_t<T> result;
+		std::memcpy(&result, ptr, sizeof(T));
+		return result;
+	}
+
+	// Convert directory record timestamp (7 bytes) to unix time
+	s64 iso_time(const u8* t)
+	{
+		const s64 y = t[0] + 1900 - (t[1] <= 2);
+		const s64 m = t[1] ? t[1] : 1;
+		const s64 era = y / 400;
+		const s64 yoe = y - era * 400;
+		const s64 doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + (t[2] ? t[2] : 1) - 1;
+		const s64 doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+		const s64 days = era * 146097 + doe - 719468;
+
+		// Offset from GMT in 15 minute intervals
+		const s64 gmt_off = static_cast<s8>(t[6]) * 15 * 60;
+
+		return days * 86400 + t[3] * 3600 + t[4] * 60 + t[5] - gmt_off;
+	}
+
+	// Decode file identifier
+	std::string iso_name(const u8* ptr, u8 len, bool joliet)
+	{
+		std::string name;
+
+		if (joliet)
+		{
+			// UCS-2 big endian
+			for (u32 i = 0; i + 1 < len; i += 2)
+			{
+				const u32 c = ptr[i] << 8 | ptr[i + 1];
+
+				if (c < 0x80)
+				{
+					name += static_cast<char>(c);
+				}
+				else if (c < 0x800)
+				{
+					name += static_cast<char>(0xc0 | c >> 6);
+					name += static_cast<char>(0x80 | (c & 0x3f));
+				}
+				else
+				{
+					name += static_cast<char>(0xe0 | c >> 12);
+					name += static_cast<char>(0x80 | (c >> 6 & 0x3f));
+					name += static_cast<char>(0x80 | (c & 0x3f));
+				}
+			}
+		}
+		else
+		{
+			name.assign(reinterpret_cast<const char*>(ptr), len);
+		}
+
+		// Remove version suffix
+		if (const usz pos = name.find_last_of(';'); pos != umax)
+		{
+			name.resize(pos);
+		}
+
+		// Remove empty extension
+		if (name.size() > 1 && name.back() == '.')
+		{
+			name.pop_back();
+		}
+
+		return name;
+	}
+
+	struct iso_file final : fs::file_base
+	{
+		const shared_ptr<iso_device::block_cache> m_cache;
+		const std::vector<std::pair<u64, u64>> m_extents;
+		const fs::stat_t m_stat;
+		fs::file m_file;
+		u64 m_pos = 0;
+
+		iso_file(shared_ptr<iso_device::block_cache> cache, fs::file&& file, const iso_device::entry& e, const fs::stat_t& stat)
+			: m_cache(std::move(cache))
+			, m_extents(e.extents)
+			, m_stat(stat)
+			, m_file(std::move(file))
+		{
+		}
+
+		fs::stat_t stat() override
+		{
+			return m_stat;
+		}
+
+		bool trunc(u64) override
+		{
+			fs::g_tls_error = fs::error::readonly;
+			return false;
+		}
+
+		u64 read(void* buffer, u64 size) override
+		{
+			u64 result = 0;
+			u64 base = 0;
+
+			for (const auto& [ext_off, ext_size] : m_extents)
+			{
+				if (result == size)
+				{
+					break;
+				}
+
+				if (m_pos >= base + ext_size)
+				{
+					base += ext_size;
+					continue;
+				}
+
+				const u64 off = m_pos - base;
+				const u64 count = std::min<u64>(size - result, ext_size - off);
+				const auto dst = static_cast<u8*>(buffer) + result;
+				u64 nread = 0;
+
+				if (count >= iso_device::block_cache::block_size)
+				{
+					// Large reads go directly to the image with the private handle
+					if (m_file.seek(ext_off + off) == ext_off + off)
+					{
+						nread = m_file.read(dst, count);
+					}
+				}
+				else
+				{
+					nread = m_cache->read(ext_off + off, dst, count);
+				}
+
+				result += nread;
+				m_pos += nread;
+
+				if (nread < count)
+				{
+					break;
+				}
+
+				base += ext_size;
+			}
+
+			return result;
+		}
+
+		u64 write(const void*, u64) override
+		{
+			fs::g_tls_error = fs::error::readonly;
+			return 0;
+		}
+
+		u64 seek(s64 offset, fs::seek_mode whence) override
+		{
+			const s64 new_pos =
+				whence == fs::seek_set ? offset :
+				whence == fs::seek_cur ? offset + m_pos :
+				whence == fs::seek_end ? offset + m_stat.size : -1;
+
+			if (new_pos < 0)
+			{
+				fs::g_tls_error = fs::error::inval;
+				return -1;
+			}
+
+			m_pos = new_pos;
+			return m_pos;
+		}
+
+		u64 size() override
+		{
+			return m_stat.size;
+		}
+	};
+
+	struct iso_dir final : fs::dir_base
+	{
+		std::vector<fs::dir_entry> m_entries;
+		usz m_pos = 0;
+
+		bool read(fs::dir_entry& out) override
+		{
+			if (m_pos >= m_entries.size())
+			{
+				return false;
+			}
+
+			out = m_entries[m_pos++];
+			return true;
+		}
+
+		void rewind() override
+		{
+			m_pos = 0;
+		}
+	};
+}
+
+u64 iso_device::block_cache::read(u64 offset, void* buffer, u64 size)
+{
+	std::lock_guard lock(mutex);
+
+	u64 result = 0;
+
+	while (result < size)
+	{
+		const u64 pos = offset + result;
+		const u64 index = pos / block_size;
+
+		block* found = nullptr;
+		block* oldest = &blocks[0];
+
+		for (auto& b : blocks)
+		{
+			if (b.index == index)
+			{
+				found = &b;
+				break;
+			}
+
+			if (b.last_use < oldest->last_use)
+			{
+				oldest = &b;
+			}
+		}
+
+		if (!found)
+		{
+			// Replace least recently used block
+			found = oldest;
+			found->index = umax;
+			found->data.resize(block_size);
+
+			if (file.seek(index * block_size) != index * block_size)
+			{
+				break;
+			}
+
+			found->size = file.read(found->data.data(), block_size);
+			found->index = index;
+		}
+
+		found->last_use = ++tick;
+
+		const u64 off = pos - index * block_size;
+
+		if (off >= found->size)
+		{
+			break;
+		}
+
+		const u64 count = std::min<u64>(size - result, found->size - off);
+		std::memcpy(static_cast<u8*>(buffer) + result, found->data.data() + off, count);
+		result += count;
+	}
+
+	return result;
+}
+
+iso_device::iso_device(const std::string& name, const std::string& path)
+	: m_name(name)
+	, m_path(path)
+	, m_root(fs_prefix + name)
+{
+	if (!parse())
+	{
+		m_entries.clear();
+		m_index.clear();
+	}
+}
+
+iso_device::~iso_device()
+{
+}
+
+bool iso_device::parse()
+{
+	fs::file image(m_path);
+
+	if (!image)
+	{
+		iso_log.error("Failed to open image '%s' (%s)", m_path, fs::g_tls_error);
+		return false;
+	}
+
+	std::array<u8, iso_sector_size> sector{};
+	std::array<u8, 34> root_record{};
+	bool found = false;
+	bool joliet = false;
+
+	// Scan volume descriptors, prefer Joliet names if available
+	for (u64 lba = 16; lba < 16 + 64; lba++)
+	{
+		if (image.seek(lba * iso_sector_size) != lba * iso_sector_size || image.read(sector.data(), sector.size()) != sector.size())
+		{
+			break;
+		}
+
+		if (std::memcmp(sector.data() + 1, "CD001", 5) != 0 || sector[0] == 255)
+		{
+			break;
+		}
+
+		if (read_le<u16>(sector.data() + 128) != iso_sector_size)
+		{
+			// Unsupported logical block size
+			continue;
+		}
+
+		if (sector[0] == 1 && !found)
+		{
+			std::memcpy(root_record.data(), sector.data() + 156, root_record.size());
+			m_volume_size = read_le<u32>(sector.data() + 80) * iso_sector_size;
+			found = true;
+		}
+		else if (sector[0] == 2 && sector[88] == '%' && sector[89] == '/' && (sector[90] == '@' || sector[90] == 'C' || sector[90] == 'E'))
+		{
+			std::memcpy(root_record.data(), sector.data() + 156, root_record.size());
+			m_volume_size = read_le<u32>(sector.data() + 80) * iso_sector_size;
+			found = true;
+			joliet = true;
+		}
+	}
+
+	if (!found)
+	{
+		iso_log.error("No ISO9660 volume descriptor found in '%s'", m_path);
+		return false;
+	}
+
+	auto& root = m_entries.emplace_back();
+	root.is_directory = true;
+	root.size = read_le<u32>(root_record.data() + 10);
+	root.extents.emplace_back(read_le<u32>(root_record.data() + 2) * iso_sector_size, root.size);
+	root.mtime = iso_time(root_record.data() + 18);
+	m_index.emplace("", 0);
+
+	if (!parse_dir(image, 0, "", joliet, 0))
+	{
+		return false;
+	}
+
+	m_cache = make_single<block_cache>();
+	m_cache->file = std::move(image);
+
+	iso_log.notice("Mounted '%s' (%u entries, joliet=%d)", m_path, m_entries.size(), joliet);
+	return true;
+}
+
+bool iso_device::parse_dir(const fs::file& image, u32 index, const std::string& path, bool joliet, u32 depth)
+{
+	if (depth > 64)
+	{
+		iso_log.error("Directory tree is too deep in '%s'", m_path);
+		return false;
+	}
+
+	// Read whole directory extent at once
+	const auto [dir_off, dir_size] = m_entries[index].extents[0];
+
+	std::vector<u8> data(dir_size);
+
+	if (image.seek(dir_off) != dir_off || image.read(data.data(), data.size()) != data.size())
+	{
+		iso_log.error("Failed to read directory '/%s' in '%s'", path, m_path);
+		return false;
+	}
+
+	std::vector<u32> subdirs;
+
+	for (u64 pos = 0; pos < data.size();)
+	{
+		const u8 len = data[pos];
+
+		if (len == 0)
+		{
+			// Records don't cross sector boundaries
+			pos = (pos / iso_sector_size + 1) * iso_sector_size;
+			continue;
+		}
+
+		if (len < 34 || pos + len > data.size() || 33 + data[pos + 32] > len)
+		{
+			iso_log.error("Invalid directory record in '/%s' in '%s'", path, m_path);
+			return false;
+		}
+
+		const u8* rec = data.data() + pos;
+		pos += len;
+
+		const u8 name_len = rec[32];
+
+		if (name_len == 1 && rec[33] <= 1)
+		{
+			// Skip '.' and '..'
+			continue;
+		}
+
+		const u8 flags = rec[25];
+		const u64 ext_off = (read_le<u32>(rec + 2) + rec[1]) * iso_sector_size;
+		const u64 ext_size = read_le<u32>(rec + 10);
+
+		std::string name = iso_name(rec + 33, name_len, joliet);
+
+		const std::string full_path = path.empty() ? name : path + '/' + name;
+		const std::string key = fmt::to_lower(full_path);
+
+		if (const auto found = m_index.find(key); found != m_index.end())
+		{
+			auto& e = m_entries[found->second];
+
+			if (!e.is_directory && !(flags & 2))
+			{
+				// Next extent of the multi-extent file
+				e.extents.emplace_back(ext_off, ext_size);
+				e.size += ext_size;
+			}
+
+			continue;
+		}
+
+		const u32 new_index = ::size32(m_entries);
+
+		auto& e = m_entries.emplace_back();
+		e.name = std::move(name);
+		e.is_directory = (flags & 2) != 0;
+		e.size = ext_size;
+		e.mtime = iso_time(rec + 18);
+		e.extents.emplace_back(ext_off, ext_size);
+
+		m_entries[index].children.push_back(new_index);
+		m_index.emplace(key, new_index);
+
+		if (e.is_directory)
+		{
+			subdirs.push_back(new_index);
+		}
+	}
+
+	for (u32 sub : subdirs)
+	{
+		const std::string sub_path = path.empty() ? m_entries[sub].name : path + '/' + m_entries[sub].name;
+
+		if (!parse_dir(image, sub, sub_path, joliet, depth + 1))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+const iso_device::entry* iso_device::find(const std::string& path) const
+{
+	if (!path.starts_with(m_root))
+	{
+		return nullptr;
+	}
+
+	// Normalize the path within the device
+	std::string key;
+
+	for (usz pos = m_root.size(); pos < path.size();)
+	{
+		const usz start = path.find_first_not_of(fs::delim, pos);
+
+		if (start == umax)
+		{
+			break;
+		}
+
+		if (start == m_root.size())
+		{
+			// Device name must be followed by delimiter
+			return nullptr;
+		}
+
+		const usz end = std::min(path.find_first_of(fs::delim, start), path.size());
+		const std::string_view name = std::string_view(path).substr(start, end - start);
+		pos = end;
+
+		if (name == ".")
+		{
+			continue;
+		}
+
+		if (name == "..")
+		{
+			const usz last = key.find_last_of('/');
+			key.resize(last == umax ? 0 : last);
+			continue;
+		}
+
+		if (!key.empty())
+		{
+			key += '/';
+		}
+
+		key += name;
+	}
+
+	if (const auto found = m_index.find(fmt::to_lower(key)); found != m_index.end())
+	{
+		return &m_entries[found->second];
+	}
+
+	return nullptr;
+}
+
+fs::stat_t iso_device::make_stat(const entry& e) const
+{
+	fs::stat_t info{};
+	info.is_directory = e.is_directory;
+	info.is_writable = false;
+	info.size = e.is_directory ? 0 : e.size;
+	info.atime = e.mtime;
+	info.mtime = e.mtime;
+	info.ctime = e.mtime;
+	return info;
+}
+
+bool iso_device::stat(const std::string& path, fs::stat_t& info)
+{
+	if (const auto e = find(path))
+	{
+		info = make_stat(*e);
+		return true;
+	}
+
+	fs::g_tls_error = fs::error::noent;
+	return false;
+}
+
+bool iso_device::statfs(const std::string& path, fs::device_stat& info)
+{
+	if (!find(path))
+	{
+		fs::g_tls_error = fs::error::noent;
+		return false;
+	}
+
+	info.block_size = iso_sector_size;
+	info.total_size = m_volume_size;
+	info.total_free = 0;
+	info.avail_free = 0;
+	return true;
+}
+
+std::unique_ptr<fs::file_base> iso_device::open(const std::string& path, bs_t<fs::open_mode> mode)
+{
+	if (mode & (fs::write + fs::append + fs::create + fs::trunc))
+	{
+		fs::g_tls_error = fs::error::readonly;
+		return nullptr;
+	}
+
+	const auto e = find(path);
+
+	if (!e)
+	{
+		fs::g_tls_error = fs::error::noent;
+		return nullptr;
+	}
+
+	if (e->is_directory)
+	{
+		fs::g_tls_error = fs::error::isdir;
+		return nullptr;
+	}
+
+	// Every opened file gets its own image handle for large reads
+	fs::file image(m_path);
+
+	if (!image)
+	{
+		return nullptr;
+	}
+
+	return std::make_unique<iso_file>(m_cache, std::move(image), *e, make_stat(*e));
+}
+
+std::unique_ptr<fs::dir_base> iso_device::open_dir(const std::string& path)
+{
+	const auto e = find(path);
+
+	if (!e)
+	{
+		fs::g_tls_error = fs::error::noent;
+		return nullptr;
+	}
+
+	if (!e->is_directory)
+	{
+		fs::g_tls_error = fs::error::exist;
+		return nullptr;
+	}
+
+	auto result = std::make_unique<iso_dir>();
+	result->m_entries.reserve(e->children.size() + 2);
+
+	for (const char* name : {".", ".."})
+	{
+		auto& entry = result->m_entries.emplace_back();
+		static_cast<fs::stat_t&>(entry) = make_stat(*e);
+		entry.name = name;
+	}
+
+	for (u32 child : e->children)
+	{
+		auto& entry = result->m_entries.emplace_back();
+		static_cast<fs::stat_t&>(entry) = make_stat(m_entries[child]);
+		entry.name = m_entries[child].name;
+	}
+
+	return result;
+}
+
+bool is_iso_file(const std::string& path)
+{
+	return path.size() > 4 && fmt::to_lower(path.substr(path.size() - 4)) == ".iso" && fs::is_file(path);
+}
+
+std::string mount_iso(const std::string& path, const std::string& name)
+{
+	auto device = make_single<iso_device>(name, path);
+
+	if (!*device)
+	{
+		return {};
+	}
+
+	std::string root = device->get_root();
+
+	// Replace previously mounted image
+	fs::set_virtual_device(name, null_ptr);
+
+	if (!fs::set_virtual_device(name, std::move(device)))
+	{
+		iso_log.error("Failed to register device '%s' (%s)", name, fs::g_tls_error);
+		return {};
+	}
+
+	return root;
+}
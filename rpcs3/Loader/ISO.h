@@ -0,0 +1,104 @@
+#pragma once
+
+#include "Utilities/File.h"
+
+#include <array>
+#include <mutex>
+#include <unordered_map>
+
+// Read-only ISO9660 (+Joliet) disc image exposed as a virtual fs device
+class iso_device final : public fs::device_base
+{
+public:
+	struct entry
+	{
+		// Original name of the entry (without version suffix)
+		std::string name;
+
+		// Byte offsets and sizes of the data extents in the image (multiple for files larger than 4 GiB)
+		std::vector<std::pair<u64, u64>> extents;
+
+		u64 size = 0;
+		s64 mtime = 0;
+		bool is_directory = false;
+
+		// Indices of the child entries (directories only)
+		std::vector<u32> children;
+	};
+
+	// Shared cache of small reads (directory records, SFO, SFB and similar hot data)
+	struct block_cache
+	{
+		static constexpr u64 block_size = 0x10000;
+
+		struct block
+		{
+			u64 index = umax;
+			u64 size = 0;
+			u64 last_use = 0;
+			std::vector<u8> data;
+		};
+
+		std::mutex mutex;
+		fs::file file;
+		std::array<block, 32> blocks;
+		u64 tick = 0;
+
+		// Read from the image through the cache
+		u64 read(u64 offset, void* buffer, u64 size);
+	};
+
+private:
+	const std::string m_name;
+	const std::string m_path;
+	const std::string m_root;
+
+	u64 m_volume_size = 0;
+
+	// All entries, the first one is the root directory
+	std::vector<entry> m_entries;
+
+	// Lowercase path (without leading slash) to entry index
+	std::unordered_map<std::string, u32> m_index;
+
+	// Shared with the opened files
+	shared_ptr<block_cache> m_cache;
+
+	bool parse();
+
+	bool parse_dir(const fs::file& image, u32 index, const std::string& path, bool joliet, u32 depth);
+
+	// Get entry for the full virtual path (nullptr if not found)
+	const entry* find(const std::string& path) const;
+
+	fs::stat_t make_stat(const entry& e) const;
+
+public:
+	iso_device(const std::string& name, const std::string& path);
+
+	~iso_device() override;
+
+	// Check if the directory index has been built successfully
+	explicit operator bool() const
+	{
+		return !m_entries.empty();
+	}
+
+	// Root path of the device (usable with fs:: functions and vfs::mount)
+	const std::string& get_root() const
+	{
+		return m_root;
+	}
+
+	bool stat(const std::string& path, fs::stat_t& info) override;
+	bool statfs(const std::string& path, fs::device_stat& info) override;
+
+	std::unique_ptr<fs::file_base> open(const std::string& path, bs_t<fs::open_mode> mode) override;
+	std::unique_ptr<fs::dir_base> open_dir(const std::string& path) override;
+};
+
+// Check if the path points to an ISO image file
+bool is_iso_file(const std::string& path);
+
+// Mount ISO image as virtual device with the given name (replaces the previous one), returns its root path or empty string on failure
+std::string mount_iso(const std::string& path, const std::string& name = "iso_bdvd");
@@ -5,6 +5,84 @@
 
 #include "PUP.h"
 
+namespace
+{
+	// Read-only window into the PUP file (avoids copying the entries to memory)
+	struct pup_file_view final : fs::file_base
+	{
+		const fs::file& m_file;
+		const u64 m_off;
+		const u64 m_size;
+		u64 m_pos = 0;
+
+		pup_file_view(const fs::file& file, u64 offset, u64 size)
+			: m_file(file)
+			, m_off(offset)
+			, m_size(size)
+		{
+		}
+
+		fs::stat_t stat() override
+		{
+			fs::stat_t stat = m_file.stat();
+			stat.is_writable = false;
+			stat.size = m_size;
+			return stat;
+		}
+
+		bool trunc(u64) override
+		{
+			return false;
+		}
+
+		u64 read(void* buffer, u64 size) override
+		{
+			if (m_pos >= m_size)
+			{
+				return 0;
+			}
+
+			size = std::min<u64>(size, m_size - m_pos);
+
+			if (m_file.seek(m_off + m_pos) != m_off + m_pos)
+			{
+				return 0;
+			}
+
+			const u64 result = m_file.read(buffer, size);
+			m_pos += result;
+			return result;
+		}
+
+		u64 write(const void*, u64) override
+		{
+			return 0;
+		}
+
+		u64 seek(s64 offset, fs::seek_mode whence) override
+		{
+			const s64 new_pos =
+				whence == fs::seek_set ? offset :
+				whence == fs::seek_cur ? offset + m_pos :
+				whence == fs::seek_end ? offset + m_size : -1;
+
+			if (new_pos < 0)
+			{
+				fs::g_tls_error = fs::error::inval;
+				return -1;
+			}
+
+			m_pos = new_pos;
+			return m_pos;
+		}
+
+		u64 size() override
+		{
+			return m_size;
+		}
+	};
+}
+
 pup_object::pup_object(fs::file&& file) : m_file(std::move(file))
 {
 	if (!m_file)
@@ -69,10 +147,9 @@ fs::file pup_object::get_file(u64 entry_id) const
 	{
 		if (file_entry.entry_id == entry_id)
 		{
-			std::vector<u8> file_buf(file_entry.data_length);
-			m_file.seek(file_entry.data_offset);
-			m_file.read(file_buf, file_entry.data_length);
-			return fs::make_stream(std::move(file_buf));
+			fs::file result;
+			result.reset(std::make_unique<pup_file_view>(m_file, file_entry.data_offset, file_entry.data_length));
+			return result;
 		}
 	}
 
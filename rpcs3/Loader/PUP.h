@@ -62,5 +62,6 @@ public:
 	explicit operator pup_error() const { return m_error; }
 	const std::string& get_formatted_error() const { return m_formatted_error; }
 
+	// Get entry as a view into the PUP file (not thread-safe, valid as long as this object exists)
 	fs::file get_file(u64 entry_id) const;
 };
@@ -156,6 +156,8 @@ bool tar_object::extract(std::string vfs_mp)
 
 	get_file(""); // Make sure we have scanned all files
 
+	std::vector<u8> buf;
+
 	for (auto& iter : m_map)
 	{
 		const TARHeader& header = iter.second.second;
@@ -198,19 +200,41 @@ bool tar_object::extract(std::string vfs_mp)
 		case '0':
 		{
 			// Create the directories which should have been mount points if vfs_mp is not empty
-			if (!vfs_mp.empty() && !fs::create_path(fs::get_parent_dir(result)))
+			// (also required when several archives are extracted concurrently into the same tree)
+			if (const std::string parent = fs::get_parent_dir(result); !fs::is_dir(parent) && !fs::create_path(parent))
 			{
 				tar_log.error("TAR Loader: failed to create directory for file %s (%s)", name, fs::g_tls_error);
 				return false;
 			}
 
-			auto data = get_file(name).release();
-
 			fs::file file(result, fs::rewrite);
 
 			if (file)
 			{
-				file.write(static_cast<fs::container_stream<std::vector<u8>>*>(data.get())->obj);
+				// Copy the data directly from the archive in blocks
+				u64 size = 0;
+				std::memcpy(&size, header.size, sizeof(size));
+
+				if (buf.empty())
+				{
+					buf.resize(0x100000);
+				}
+
+				m_file.seek(iter.second.first);
+
+				for (u64 pos = 0; pos < size;)
+				{
+					const u64 block = std::min<u64>(buf.size(), size - pos);
+
+					if (m_file.read(buf.data(), block) != block || file.write(buf.data(), block) != block)
+					{
+						tar_log.error("TAR Loader: failed to copy file %s (%s)", name, fs::g_tls_error);
+						return false;
+					}
+
+					pos += block;
+				}
+
 				file.close();
 
 				if (mtime != umax && !fs::utime(result, atime, mtime))
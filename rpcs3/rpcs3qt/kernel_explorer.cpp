@@ -651,6 +651,15 @@ void kernel_explorer::update()
 	{
 		QTreeWidgetItem* spu_tree = add_solid_node(find_node(root, additional_nodes::spu_thread_groups), qstr(fmt::format(u8"SPU Group 0x%07x: “%s”, Status = %s, Priority = %d, Type = 0x%x", id, tg.name, tg.run_state.load(), +tg.prio, tg.type)));
 
+		{
+			reader_lock lock(tg.mutex);
+
+			if (const u64 mask = tg.affinity_mask)
+			{
+				add_leaf(spu_tree, qstr(fmt::format("Host Cache Domain: %d, Affinity Mask: 0x%x", tg.cache_domain, mask)));
+			}
+		}
+
 		if (tg.name.ends_with("CellSpursKernelGroup"sv))
 		{
 			vm::ptr<CellSpurs> pspurs{};
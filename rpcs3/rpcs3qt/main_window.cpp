@@ -1230,12 +1230,22 @@ void main_window::HandlePupInstallation(const QString& file_path, const QString&
 	// Synchronization variable
 	atomic_t<uint> progress(0);
 	{
-		// Run asynchronously
-		named_thread worker("Firmware Installer", [&]
+		// Every dev_flash_* package is independent, decrypt and extract them in parallel
+		atomic_t<usz> next_package = 0;
+		std::mutex tar_mutex;
+
+		named_thread_group workers("Firmware Installer ", std::min<u32>(utils::get_thread_count(), ::size32(update_filenames)), [&]
 		{
-			for (const auto& update_filename : update_filenames)
+			for (usz i = next_package++; i < update_filenames.size() && progress < update_filenames.size(); i = next_package++)
 			{
-				fs::file update_file = update_files.get_file(update_filename);
+				const std::string& update_filename = update_filenames[i];
+
+				fs::file update_file;
+				{
+					// The archive reads through a shared PUP file handle
+					std::lock_guard lock(tar_mutex);
+					update_file = update_files.get_file(update_filename);
+				}
 
 				SCEDecrypter self_dec(update_file);
 				self_dec.LoadHeaders();
@@ -1285,8 +1295,8 @@ void main_window::HandlePupInstallation(const QString& file_path, const QString&
 			QCoreApplication::processEvents();
 		}
 
-		// Join thread
-		worker();
+		// Join threads
+		workers.join();
 	}
 
 	update_files_f.close();